@@ -0,0 +1,37 @@
+// Builds structs with many appended fields the way the parser does (variable(), type(), then append() and bit_append()
+// for bitfields), to show that appending stays cheap as the struct grows.
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include <sdkgenny.hpp>
+
+int main(int argc, char* argv[]) {
+    for (auto num_fields : {5'000, 10'000, 20'000}) {
+        sdkgenny::Sdk sdk{};
+        auto g = sdk.global_ns();
+        auto int_t = g->type("int")->size(4);
+        auto uint8_t_t = g->type("uint8_t")->size(1);
+        auto s = g->struct_("Huge");
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (auto i = 0; i < num_fields; ++i) {
+            auto var = s->variable("field" + std::to_string(i));
+
+            // Every fourth field is a 3 bit bitfield, so runs of them pack into shared storage units.
+            if (i % 4 == 0) {
+                var->type(uint8_t_t)->bit_size(3)->append()->bit_append();
+            } else {
+                var->type(int_t)->append();
+            }
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        auto ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        std::printf("%6d fields: append %9.2f ms, size 0x%zx\n", num_fields, ms, s->size());
+    }
+
+    return 0;
+}
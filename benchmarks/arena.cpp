@@ -0,0 +1,105 @@
+// Builds and tears down a large tree both inside of an Sdk (where objects come from the Sdk's arena) and inside of a
+// detached namespace (where every object is its own heap allocation) and reports the time and number of heap
+// allocations each takes.
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include <sdkgenny.hpp>
+
+static std::atomic_size_t g_allocations{};
+static std::atomic_size_t g_frees{};
+
+void* operator new(size_t size) {
+    ++g_allocations;
+
+    if (auto p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept {
+    if (p != nullptr) {
+        ++g_frees;
+        std::free(p);
+    }
+}
+
+void operator delete(void* p, size_t) noexcept {
+    operator delete(p);
+}
+
+// std::pmr::new_delete_resource() goes through the aligned overloads.
+void* operator new(size_t size, std::align_val_t align) {
+    ++g_allocations;
+
+    auto alignment = static_cast<size_t>(align);
+
+    if (auto p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) {
+        return p;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    operator delete(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+    operator delete(p);
+}
+
+constexpr auto NUM_STRUCTS = 50'000;
+constexpr auto NUM_FIELDS = 20;
+
+void build(sdkgenny::Namespace* g) {
+    auto i32 = g->type("int")->size(4);
+
+    for (auto i = 0; i < NUM_STRUCTS; ++i) {
+        auto s = g->struct_("Struct" + std::to_string(i));
+
+        for (auto j = 0; j < NUM_FIELDS; ++j) {
+            s->variable("field" + std::to_string(j))->type(i32)->offset(j * 4);
+        }
+    }
+}
+
+template <typename Fn> void measure(const char* name, Fn&& fn) {
+    auto allocations = g_allocations.load();
+    auto frees = g_frees.load();
+    auto start = std::chrono::steady_clock::now();
+
+    fn();
+
+    auto end = std::chrono::steady_clock::now();
+
+    std::printf("%-28s %9.2f ms %10zu allocations %10zu frees\n", name,
+        std::chrono::duration<double, std::milli>(end - start).count(), g_allocations.load() - allocations,
+        g_frees.load() - frees);
+}
+
+int main(int argc, char* argv[]) {
+    std::printf("%d structs with %d fields each\n", NUM_STRUCTS, NUM_FIELDS);
+
+    {
+        auto ns = std::make_unique<sdkgenny::Namespace>("");
+
+        measure("heap build", [&] { build(ns.get()); });
+        measure("heap teardown", [&] { ns.reset(); });
+    }
+
+    {
+        auto sdk = std::make_unique<sdkgenny::Sdk>();
+
+        measure("arena build", [&] { build(sdk->global_ns()); });
+        measure("arena teardown", [&] { sdk.reset(); });
+    }
+
+    return 0;
+}
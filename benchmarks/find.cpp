@@ -0,0 +1,36 @@
+// Builds namespaces with an increasing number of structs (each with an auto-created pointer type) to show that
+// find_or_add scales linearly with the number of children.
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include <sdkgenny.hpp>
+
+int main(int argc, char* argv[]) {
+    for (auto num_structs : {12'500, 25'000, 50'000, 100'000}) {
+        sdkgenny::Sdk sdk{};
+        auto g = sdk.global_ns();
+        auto start = std::chrono::steady_clock::now();
+
+        for (auto i = 0; i < num_structs; ++i) {
+            auto s = g->struct_("Struct" + std::to_string(i));
+
+            s->variable("self")->type(s->ptr())->append();
+        }
+
+        // Look every struct up again like the parser does when resolving types.
+        for (auto i = 0; i < num_structs; ++i) {
+            if (g->find<sdkgenny::Struct>("Struct" + std::to_string(i)) == nullptr) {
+                std::printf("Failed to find Struct%d\n", i);
+                return 1;
+            }
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        auto ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        std::printf("%7d structs: %9.2f ms (%6.1f ns/struct)\n", num_structs, ms, ms * 1'000'000.0 / num_structs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+// Strips the functions and constants from every struct like the IDA transform does, then removes every struct of a
+// namespace one at a time, to show that both batched and single removal scale linearly.
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <sdkgenny.hpp>
+
+int main(int argc, char* argv[]) {
+    constexpr auto num_members = 16;
+
+    for (auto num_structs : {12'500, 25'000, 50'000}) {
+        sdkgenny::Sdk sdk{};
+        auto g = sdk.global_ns();
+        auto int_t = g->type("int")->size(4);
+        std::vector<sdkgenny::Struct*> structs{};
+
+        for (auto i = 0; i < num_structs; ++i) {
+            auto s = g->struct_("Struct" + std::to_string(i));
+
+            for (auto j = 0; j < num_members; ++j) {
+                s->variable("field" + std::to_string(j))->type(int_t)->append();
+                s->function("function" + std::to_string(j));
+                s->constant("constant" + std::to_string(j))->type(int_t);
+            }
+
+            structs.emplace_back(s);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (auto&& s : structs) {
+            s->remove_all<sdkgenny::Function>();
+            s->remove_all<sdkgenny::Constant>();
+        }
+
+        auto mid = std::chrono::steady_clock::now();
+
+        for (auto&& s : structs) {
+            if (g->remove(s) == nullptr) {
+                std::printf("Failed to remove %s\n", s->name().c_str());
+                return 1;
+            }
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        auto strip_ms = std::chrono::duration<double, std::milli>(mid - start).count();
+        auto remove_ms = std::chrono::duration<double, std::milli>(end - mid).count();
+
+        std::printf(
+            "%6d structs: strip %9.2f ms, remove one by one %9.2f ms\n", num_structs, strip_ms, remove_ms);
+    }
+
+    return 0;
+}
@@ -0,0 +1,34 @@
+// Generates huge structs that only have a handful of fields (like a big singleton with a few known members), to show
+// that layout emission scales with the number of fields rather than the size of the struct.
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+
+#include <sdkgenny.hpp>
+
+int main(int argc, char* argv[]) {
+    constexpr auto num_fields = 8;
+
+    for (auto struct_size : {1 << 20, 16 << 20, 64 << 20}) {
+        sdkgenny::Sdk sdk{};
+        auto g = sdk.global_ns();
+        auto int_t = g->type("int")->size(4);
+        auto s = g->struct_("Singleton")->size(struct_size);
+
+        for (auto i = 0; i < num_fields; ++i) {
+            s->variable("field" + std::to_string(i))->type(int_t)->offset(struct_size / num_fields * i);
+        }
+
+        std::ostringstream os{};
+        auto start = std::chrono::steady_clock::now();
+
+        s->generate(os);
+
+        auto end = std::chrono::steady_clock::now();
+        auto ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        std::printf("0x%08x byte struct: generate %9.2f ms, %zu bytes of output\n", struct_size, ms, os.str().size());
+    }
+
+    return 0;
+}
@@ -1,6 +1,6 @@
 #!/usr/bin/env sh
 
-find include src examples -type f \( -name "*.hpp" -o -name "*.cpp" \) |
+find include src examples benchmarks -type f \( -name "*.hpp" -o -name "*.cpp" \) |
 while read file; do
     echo "$file"
     clang-format -i -style=file "$file"
@@ -11,7 +11,18 @@ public:
 
     auto of() const { return m_of; }
     auto of(Type* of) {
+        if (m_of != nullptr && m_of != of) {
+            m_of->remove_size_dependent(this);
+        }
+
         m_of = of;
+
+        if (of != nullptr) {
+            of->add_size_dependent(this);
+        }
+
+        size_changed();
+        dependencies_changed();
         return this;
     }
 
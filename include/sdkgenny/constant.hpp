@@ -15,6 +15,7 @@ public:
     auto type() const { return m_type; }
     auto type(Type* type) {
         m_type = type;
+        dependencies_changed();
         return this;
     }
 
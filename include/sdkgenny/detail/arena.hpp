@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+
+#include <sdkgenny/detail/string_pool.hpp>
+
+namespace sdkgenny::detail {
+// The memory an Sdk allocates its objects from, and the pool their names are interned into. The Sdk and every object
+// allocated from it hold a reference, so it's all released at once when the last of them is gone. That may be an object
+// removed from the Sdk that outlives it.
+class Arena : public std::pmr::monotonic_buffer_resource {
+public:
+    // Makes an arena with a single reference, owned by the caller.
+    static Arena* create() { return new Arena{}; }
+
+    StringPool* string_pool() { return &m_string_pool; }
+
+    void retain() { m_refs.fetch_add(1, std::memory_order_relaxed); }
+    void release() {
+        if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    // Lets a std::unique_ptr hold a reference.
+    struct Release {
+        void operator()(Arena* arena) const { arena->release(); }
+    };
+
+private:
+    std::atomic<size_t> m_refs{1};
+    StringPool m_string_pool{this};
+
+    Arena() = default;
+};
+} // namespace sdkgenny::detail
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <functional>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace sdkgenny::detail {
+// Hashes every kind of string by its characters so containers keyed by strings can be searched with a std::string_view.
+struct StringHash {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view str) const { return std::hash<std::string_view>{}(str); }
+};
+
+// Deduplicates strings. A pooled string keeps its address for as long as the pool is alive so two pooled strings from
+// the same pool are equal if and only if they are the same object.
+class StringPool {
+public:
+    explicit StringPool(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    const std::string& intern(std::string_view str);
+
+    // Returns the pooled copy of a string or nullptr if it was never interned.
+    const std::string* find(std::string_view str) const;
+
+    auto size() const { return m_strings.size(); }
+
+    // The pool newly constructed objects on this thread intern their names into. Set by Object::make() so objects
+    // created within an Sdk never have to own a copy of their name.
+    static StringPool* current() { return s_current; }
+
+    class Scope {
+    public:
+        explicit Scope(StringPool* pool) : m_previous{s_current} { s_current = pool; }
+        ~Scope() { s_current = m_previous; }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        StringPool* m_previous{};
+    };
+
+private:
+    std::pmr::unordered_set<std::string, StringHash, std::equal_to<>> m_strings;
+
+    static thread_local StringPool* s_current;
+};
+} // namespace sdkgenny::detail
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sdkgenny::detail {
+// A fixed set of threads that split loops between them. Each thread starts on its own share of the indices and, once
+// that's done, steals half of what's left of another thread's share, so uneven work still balances out.
+class ThreadPool {
+public:
+    // The calling thread counts as one of the threads, so 1 runs everything serially on it. 0 uses one per core.
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    auto size() const { return m_workers.size() + 1; }
+
+    // Calls fn for every index below count and returns once all of them are done. The first exception thrown by fn is
+    // rethrown here after the rest of the calls have finished.
+    void parallel_for(size_t count, const std::function<void(size_t)>& fn);
+
+private:
+    // The indices [begin, end) a thread has left, packed as begin << 32 | end so taking from either side is one CAS.
+    struct alignas(64) Share {
+        std::atomic<uint64_t> bounds{};
+    };
+
+    std::vector<std::thread> m_workers{};
+    std::unique_ptr<Share[]> m_shares{};
+
+    std::mutex m_mutex{};
+    std::condition_variable m_start{};
+    std::condition_variable m_done{};
+    uint64_t m_generation{};
+    size_t m_busy{};
+    bool m_stop{};
+
+    // The loop being run: indices in the shares are relative to m_base.
+    const std::function<void(size_t)>* m_fn{};
+    size_t m_base{};
+    std::exception_ptr m_exception{};
+
+    void work(size_t self);
+    void call(size_t index);
+};
+} // namespace sdkgenny::detail
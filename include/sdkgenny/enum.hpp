@@ -16,7 +16,17 @@ public:
 
     auto type() const { return m_type; }
     auto type(Type* type) {
+        if (m_type != nullptr && m_type != type) {
+            m_type->remove_size_dependent(this);
+        }
+
         m_type = type;
+
+        if (type != nullptr) {
+            type->add_size_dependent(this);
+        }
+
+        size_changed();
         return this;
     }
 
@@ -19,6 +19,7 @@ public:
     auto returns() const { return m_return_value; }
     auto returns(Type* return_value) {
         m_return_value = return_value;
+        dependencies_changed();
         return this;
     }
 
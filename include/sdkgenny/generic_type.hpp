@@ -12,6 +12,7 @@ public:
     auto&& template_types() const { return m_template_types; }
     auto template_type(Type* type) {
         m_template_types.emplace(type);
+        dependencies_changed();
         return this;
     }
 
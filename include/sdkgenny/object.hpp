@@ -1,30 +1,201 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <filesystem>
 #include <functional>
+#include <iterator>
 #include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <ranges>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <format>
 
+#include <sdkgenny/detail/arena.hpp>
+
 namespace sdkgenny {
+class Array;
+class Class;
+class Constant;
+class Enum;
+class EnumClass;
+class Function;
+class GenericType;
+class Namespace;
+class Object;
+class Parameter;
+class Pointer;
+class Reference;
+class Sdk;
+class StaticFunction;
 class Struct;
+class TemplateParameter;
+class Type;
+class Typename;
+class Variable;
+class VirtualFunction;
+
+namespace detail {
+template <typename T> class OwnerView;
+
+// Identifies the concrete classes of the library. Every object carries the bit of its own class and the bits of all of
+// its bases so testing for a class is a single mask test that respects the class hierarchy.
+enum Kind : uint32_t {
+    KIND_NONE = 0,
+    KIND_TYPENAME = 1u << 0,
+    KIND_NAMESPACE = 1u << 1,
+    KIND_TYPE = 1u << 2,
+    KIND_STRUCT = 1u << 3,
+    KIND_CLASS = 1u << 4,
+    KIND_ENUM = 1u << 5,
+    KIND_ENUM_CLASS = 1u << 6,
+    KIND_REFERENCE = 1u << 7,
+    KIND_POINTER = 1u << 8,
+    KIND_ARRAY = 1u << 9,
+    KIND_GENERIC_TYPE = 1u << 10,
+    KIND_TEMPLATE_PARAMETER = 1u << 11,
+    KIND_VARIABLE = 1u << 12,
+    KIND_CONSTANT = 1u << 13,
+    KIND_PARAMETER = 1u << 14,
+    KIND_FUNCTION = 1u << 15,
+    KIND_VIRTUAL_FUNCTION = 1u << 16,
+    KIND_STATIC_FUNCTION = 1u << 17,
+    KIND_SDK = 1u << 18,
+};
+
+// Classes without a kind (ones defined outside of the library) fall back to dynamic_cast.
+template <typename T> constexpr uint32_t kind_of = KIND_NONE;
+template <> inline constexpr uint32_t kind_of<Typename> = KIND_TYPENAME;
+template <> inline constexpr uint32_t kind_of<Namespace> = KIND_NAMESPACE;
+template <> inline constexpr uint32_t kind_of<Type> = KIND_TYPE;
+template <> inline constexpr uint32_t kind_of<Struct> = KIND_STRUCT;
+template <> inline constexpr uint32_t kind_of<Class> = KIND_CLASS;
+template <> inline constexpr uint32_t kind_of<Enum> = KIND_ENUM;
+template <> inline constexpr uint32_t kind_of<EnumClass> = KIND_ENUM_CLASS;
+template <> inline constexpr uint32_t kind_of<Reference> = KIND_REFERENCE;
+template <> inline constexpr uint32_t kind_of<Pointer> = KIND_POINTER;
+template <> inline constexpr uint32_t kind_of<Array> = KIND_ARRAY;
+template <> inline constexpr uint32_t kind_of<GenericType> = KIND_GENERIC_TYPE;
+template <> inline constexpr uint32_t kind_of<TemplateParameter> = KIND_TEMPLATE_PARAMETER;
+template <> inline constexpr uint32_t kind_of<Variable> = KIND_VARIABLE;
+template <> inline constexpr uint32_t kind_of<Constant> = KIND_CONSTANT;
+template <> inline constexpr uint32_t kind_of<Parameter> = KIND_PARAMETER;
+template <> inline constexpr uint32_t kind_of<Function> = KIND_FUNCTION;
+template <> inline constexpr uint32_t kind_of<VirtualFunction> = KIND_VIRTUAL_FUNCTION;
+template <> inline constexpr uint32_t kind_of<StaticFunction> = KIND_STATIC_FUNCTION;
+template <> inline constexpr uint32_t kind_of<Sdk> = KIND_SDK;
+
+// Children of these kinds are also kept in per-kind buckets, in declaration order, so iterating them doesn't mean
+// filtering every other child. A child is in every bucket its kind matches (a VirtualFunction is also a Function).
+enum Bucket : uint32_t {
+    BUCKET_VARIABLE,
+    BUCKET_CONSTANT,
+    BUCKET_FUNCTION,
+    BUCKET_VIRTUAL_FUNCTION,
+    BUCKET_ENUM,
+    BUCKET_STRUCT,
+    BUCKET_NAMESPACE,
+    BUCKET_COUNT,
+};
+
+inline constexpr uint32_t bucket_kinds[BUCKET_COUNT] = {
+    KIND_VARIABLE, KIND_CONSTANT, KIND_FUNCTION, KIND_VIRTUAL_FUNCTION, KIND_ENUM, KIND_STRUCT, KIND_NAMESPACE};
+inline constexpr uint32_t BUCKETED_KINDS =
+    KIND_VARIABLE | KIND_CONSTANT | KIND_FUNCTION | KIND_VIRTUAL_FUNCTION | KIND_ENUM | KIND_STRUCT | KIND_NAMESPACE;
+
+template <typename T> constexpr auto bucket_of = BUCKET_COUNT;
+template <> inline constexpr auto bucket_of<Variable> = BUCKET_VARIABLE;
+template <> inline constexpr auto bucket_of<Constant> = BUCKET_CONSTANT;
+template <> inline constexpr auto bucket_of<Function> = BUCKET_FUNCTION;
+template <> inline constexpr auto bucket_of<VirtualFunction> = BUCKET_VIRTUAL_FUNCTION;
+template <> inline constexpr auto bucket_of<Enum> = BUCKET_ENUM;
+template <> inline constexpr auto bucket_of<Struct> = BUCKET_STRUCT;
+template <> inline constexpr auto bucket_of<Namespace> = BUCKET_NAMESPACE;
+
+// Produces a name through a policy and caches it until the object is renamed or a new policy is installed. Copying one
+// copies its policy but not its cache.
+class UsableName {
+public:
+    using Policy = std::function<std::string()>;
+
+    UsableName(Object* object, Policy policy) : m_object{object}, m_policy{std::move(policy)} {}
+    UsableName(const UsableName& other) : m_object{other.m_object}, m_policy{other.m_policy} {}
+
+    UsableName& operator=(const UsableName& other) {
+        m_policy = other.m_policy;
+        policy_changed();
+        return *this;
+    }
+
+    UsableName& operator=(Policy policy) {
+        m_policy = std::move(policy);
+        policy_changed();
+        return *this;
+    }
+
+    const std::string& operator()() const {
+        if (!m_is_cached) {
+            m_cache = m_policy();
+            m_is_cached = true;
+        }
+
+        return m_cache;
+    }
+
+    void invalidate() { m_is_cached = false; }
+
+private:
+    Object* m_object{};
+    Policy m_policy{};
+    mutable std::string m_cache{};
+    mutable bool m_is_cached{};
+
+    void policy_changed();
+};
+} // namespace detail
 
 class Object {
 public:
     Object() = delete;
     explicit Object(std::string_view name);
-    virtual ~Object() = default;
+    virtual ~Object();
 
-    const auto& name() const { return m_name; }
-    auto name(std::string name) {
-        m_name = std::move(name);
-        return this;
+    // Objects created through make() (and therefore find_or_add() and friends) while attached to an Sdk are allocated
+    // from that Sdk's arena. Deleting them only runs their destructor; the memory itself is released all at once along
+    // with the arena, which each of them keeps alive, so they may outlive the Sdk (see remove()).
+    static void* operator new(size_t size);
+    static void* operator new(size_t size, detail::Arena* arena);
+    static void operator delete(void* p);
+    static void operator delete(void* p, detail::Arena* arena);
+
+    // The arena new children of this object are allocated from, or nullptr if this object isn't part of an Sdk.
+    detail::Arena* arena() const;
+
+    // The pool names of objects within the same Sdk as this one are interned into, or nullptr if this object isn't part
+    // of an Sdk.
+    detail::StringPool* string_pool() const;
+
+    template <typename T, typename... TArgs> std::unique_ptr<T> make(TArgs&&... args) const {
+        detail::StringPool::Scope scope{string_pool()};
+        auto arena = this->arena();
+        std::unique_ptr<T> object{new (arena) T(std::forward<TArgs>(args)...)};
+
+        object->m_home_arena = arena;
+
+        return object;
     }
 
+    const std::string& name() const { return *m_name; }
+    Object* name(std::string name);
+
     const auto& metadata() const { return m_metadata; }
     auto& metadata() { return m_metadata; }
     virtual void generate_metadata(std::ostream& os) const;
@@ -44,12 +215,35 @@ public:
     }
     virtual void generate_comment(std::ostream& os) const;
 
-    template <typename T> bool is_a() const { return dynamic_cast<const T*>(this) != nullptr; }
-    template <typename T> const T* as() const { return dynamic_cast<const T*>(this); }
-    template <typename T> T* as() { return dynamic_cast<T*>(this); }
+    template <typename T> bool is_a() const {
+        using U = std::remove_cv_t<T>;
+
+        if constexpr (std::is_same_v<U, Object>) {
+            return true;
+        } else if constexpr (detail::kind_of<U> != detail::KIND_NONE) {
+            return (m_kind & detail::kind_of<U>) != 0;
+        } else {
+            return dynamic_cast<const T*>(this) != nullptr;
+        }
+    }
+    template <typename T> const T* as() const { return is_a<T>() ? static_cast<const T*>(this) : nullptr; }
+    template <typename T> T* as() { return is_a<T>() ? static_cast<T*>(this) : nullptr; }
+
+    auto kind() const { return m_kind; }
 
-    // Searches for an owner of the correct type.
+    // Searches for an owner of the correct type. The closest Namespace, Struct and Sdk are cached whenever the object is
+    // added to or removed from an owner so those don't have to be searched for at all.
     template <typename T> const T* owner() const {
+        using U = std::remove_cv_t<T>;
+
+        if constexpr (std::is_same_v<U, Namespace>) {
+            return m_owner_ns;
+        } else if constexpr (std::is_same_v<U, Struct>) {
+            return m_owner_struct;
+        } else if constexpr (std::is_same_v<U, Sdk>) {
+            return m_sdk;
+        }
+
         for (auto owner = m_owner; owner != nullptr; owner = owner->m_owner) {
             if (owner->is_a<T>()) {
                 return (const T*)owner;
@@ -77,13 +271,27 @@ public:
 
     auto direct_owner() const { return m_owner; }
 
+    // Lazily filtered views of the owners and children of the correct type. Unlike owners() and get_all() they don't
+    // allocate, but they view the tree directly so it must not be modified while iterating them.
+    template <typename T> detail::OwnerView<T> owner_view() const { return detail::OwnerView<T>{m_owner}; }
+
+    template <typename T> auto child_view() const {
+        using U = std::remove_cv_t<T>;
+
+        if constexpr (detail::bucket_of<U> != detail::BUCKET_COUNT) {
+            return child_bucket(detail::bucket_of<U>) | std::views::filter([](Object* child) { return child != nullptr; }) |
+                   std::views::transform([](Object* child) { return (T*)child; });
+        } else {
+            return live_children() | std::views::filter([](Object* child) { return child->template is_a<T>(); }) |
+                   std::views::transform([](Object* child) { return (T*)child; });
+        }
+    }
+
     template <typename T> std::vector<T*> owners() const {
         std::vector<T*> owners{};
 
-        for (auto owner = m_owner; owner != nullptr; owner = owner->m_owner) {
-            if (owner->is_a<T>()) {
-                owners.emplace_back((T*)owner);
-            }
+        for (auto owner : owner_view<T>()) {
+            owners.emplace_back(owner);
         }
 
         return owners;
@@ -92,10 +300,8 @@ public:
     template <typename T> std::vector<T*> get_all() const {
         std::vector<T*> children{};
 
-        for (auto&& child : m_children) {
-            if (child->is_a<T>()) {
-                children.emplace_back((T*)child.get());
-            }
+        for (auto child : child_view<T>()) {
+            children.emplace_back(child);
         }
 
         return children;
@@ -106,37 +312,84 @@ public:
             objects.emplace((T*)this);
         }
 
-        for (auto&& child : m_children) {
+        for (Object* child : live_children()) {
             child->get_all_in_children(objects);
         }
     }
 
     template <typename T> bool has_any() const {
-        return std::any_of(
-            m_children.cbegin(), m_children.cend(), [](const auto& child) { return child->template is_a<T>(); });
+        auto children = child_view<T>();
+        return children.begin() != children.end();
     }
 
     template <typename T> bool has_any_in_children() const {
-        return std::any_of(m_children.cbegin(), m_children.cend(),
-            [](const auto& child) { return child->template is_a<T>() || child->template has_any_in_children<T>(); });
+        return std::ranges::any_of(live_children(),
+            [](Object* child) { return child->template is_a<T>() || child->template has_any_in_children<T>(); });
     }
 
-    template <typename T> bool is_child_of(T* obj) const {
-        const auto o = owners<T>();
-        return std::any_of(o.cbegin(), o.cend(), [obj](const auto& owner) { return owner == obj; });
-    }
+    template <typename T> bool is_child_of(T* obj) const { return is_owned_by(obj); }
+
+    // Whether obj is one of this object's owners, directly or not. Within an Sdk this is answered with the pre/post-order
+    // numbers of the object tree.
+    bool is_owned_by(const Object* obj) const;
 
     bool is_direct_child_of(Object* obj) const { return m_owner == obj; }
 
     template <typename T> T* add(std::unique_ptr<T> object) {
         object->m_owner = this;
-        return (T*)m_children.emplace_back(std::move(object)).get();
+        object->relink();
+        structure_changed();
+
+        object->m_slot = (uint32_t)m_children.size();
+        auto child = (T*)m_children.emplace_back(std::move(object)).get();
+
+        if ((child->m_kind & detail::BUCKETED_KINDS) != 0) {
+            bucket_child(child);
+        }
+
+        if (m_child_index != nullptr) {
+            child_index_entry(*child->m_name).emplace_back(child);
+        } else if (m_children.size() >= CHILD_INDEX_THRESHOLD) {
+            build_child_index();
+        }
+
+        return child;
     }
 
     template <typename T> T* find(std::string_view name) const {
-        for (auto&& child : m_children) {
-            if (child->is_a<T>() && child->m_name == name) {
-                return (T*)child.get();
+        if (m_child_index != nullptr) {
+            if (auto search = m_child_index->find(name); search != m_child_index->end()) {
+                for (auto&& child : search->second) {
+                    if (child->is_a<T>()) {
+                        return (T*)child;
+                    }
+                }
+            }
+
+            return nullptr;
+        }
+
+        // The names of objects within an Sdk are interned so a name that isn't in the pool can't belong to any of our
+        // children and the ones that can are found by address.
+        if (auto pool = string_pool()) {
+            auto interned = pool->find(name);
+
+            if (interned == nullptr) {
+                return nullptr;
+            }
+
+            for (Object* child : live_children()) {
+                if (child->m_name == interned && child->is_a<T>()) {
+                    return (T*)child;
+                }
+            }
+
+            return nullptr;
+        }
+
+        for (Object* child : live_children()) {
+            if (child->is_a<T>() && *child->m_name == name) {
+                return (T*)child;
             }
         }
 
@@ -160,7 +413,7 @@ public:
             return search;
         }
 
-        return add(std::make_unique<T>(name, args...));
+        return add(make<T>(name, args...));
     }
 
     template <typename T, typename... TArgs> T* find_in_owners_or_add(std::string_view name, TArgs... args) {
@@ -168,26 +421,45 @@ public:
             return search;
         }
 
-        return add(std::make_unique<T>(name, args...));
+        return add(make<T>(name, args...));
     }
 
-    // Returns the unique_ptr to the removed object.
+    // Returns the unique_ptr to the removed object, which owns it like any other and may outlive the Sdk it was removed
+    // from: an object allocated from the Sdk's arena keeps the arena alive until it's destroyed. What it refers to that
+    // stayed in the Sdk (the types of its variables, its parents, ...) is destroyed along with the Sdk though. Removing
+    // a child leaves a hole in place of it that is compacted away once holes make
+    // up half the children (the kind buckets work the same way), so this takes constant amortized time.
     std::unique_ptr<Object> remove(Object* obj);
 
-    template <typename T> void remove_all() {
-        for (auto&& child : get_all<T>()) {
-            remove(child);
+    // Removes every child pred returns true for in a single pass. Returns the removed objects in declaration order.
+    template <typename TPred> std::vector<std::unique_ptr<Object>> remove_if(TPred pred) {
+        std::vector<std::unique_ptr<Object>> removed{};
+
+        for (auto&& child : m_children) {
+            if (child != nullptr && pred(child.get())) {
+                removed.emplace_back(std::move(child));
+            }
         }
+
+        if (!removed.empty()) {
+            children_removed(removed);
+        }
+
+        return removed;
+    }
+
+    template <typename T> void remove_all() {
+        remove_if([](Object* child) { return child->template is_a<T>(); });
     }
 
     // Will fix up a desired name so that it's usable as a C++ identifier. Things like spaces get converted to
     // underscores, and we make sure it doesn't begin with a number. More checks could be done here in the future if
-    // necessary.
-    std::function<std::string()> usable_name = [this] {
+    // necessary. Assigning a callable to it installs a different naming policy.
+    detail::UsableName usable_name{this, [this] {
         std::string name{};
         constexpr auto allowed_chars = "*&[]:";
 
-        for (auto&& c : m_name) {
+        for (auto&& c : *m_name) {
             auto cc = static_cast<unsigned char>(c);
 
             if (!std::isalnum(cc) && std::strchr(allowed_chars, cc) == nullptr) {
@@ -202,12 +474,18 @@ public:
         }
 
         return name;
-    };
+    }};
 
     // The name used when declaring the object (only for types).
-    std::function<std::string()> usable_name_decl = usable_name;
+    detail::UsableName usable_name_decl = usable_name;
 
-    std::filesystem::path path();
+    // The path of the header (without an extension) this object is generated into, relative to the Sdk. Cached until
+    // the object or one of its owners is renamed or moved.
+    std::filesystem::path path() const;
+
+    // The usable names of this object and its owners joined by "::", up to the global namespace. Cached the same way as
+    // path().
+    const std::string& qualified_name() const;
 
     auto skip_generation(bool g) {
         m_skip_generation = g;
@@ -219,15 +497,195 @@ protected:
     friend class Type;
     friend class Pointer;
     friend class Namespace;
+    friend class Struct;
     friend class Sdk;
+    friend class detail::UsableName;
+
+    // Objects with at least this many children get a hashed name index so find() doesn't have to scan them all.
+    static constexpr size_t CHILD_INDEX_THRESHOLD = 16;
+
+    // Maps a name to every child with that name, in the same order they appear in m_children. The keys are copies so
+    // they stay valid whichever of the children sharing a name is removed, destroyed or renamed first. Allocated from
+    // resource().
+    using ChildIndex = std::pmr::unordered_map<std::pmr::string, std::pmr::vector<Object*>, detail::StringHash,
+        std::equal_to<>>;
+
+    // One vector per detail::Bucket, which may contain nullptr holes like m_children. Only allocated (from resource())
+    // once a child of a bucketed kind is added.
+    struct ChildBuckets {
+        explicit ChildBuckets(std::pmr::memory_resource* resource) : objects(detail::BUCKET_COUNT, resource) {}
+
+        std::pmr::vector<std::pmr::vector<Object*>> objects;
+        uint32_t holes[detail::BUCKET_COUNT]{};
+    };
 
     Object* m_owner{};
+    uint32_t m_kind{detail::KIND_NONE};
+
+    // Position of this object in a pre/post-order walk of its Sdk, see Sdk::is_owned_by().
+    mutable uint32_t m_pre{};
+    mutable uint32_t m_post{};
+
+    // Where this object is in its owner's m_children and kind buckets (it's in two at most), and how many holes removed
+    // children left in ours.
+    uint32_t m_slot{};
+    uint32_t m_bucket_slots[2]{};
+    uint32_t m_holes{};
 
-    std::string m_name{};
+    // The arena this object was allocated from by make(), if any.
+    detail::Arena* m_home_arena{};
+
+    // The closest owners of these types, kept up to date by relink().
+    Sdk* m_sdk{};
+    Namespace* m_owner_ns{};
+    Struct* m_owner_struct{};
+
+    struct NameCache {
+        std::optional<std::filesystem::path> path{};
+        std::optional<std::string> qualified_name{};
+    };
+
+    // Only allocated once something asks for a path or qualified name.
+    mutable std::unique_ptr<NameCache> m_name_cache{};
+
+    // Points into m_name_pool, or at m_own_name while the object isn't part of an Sdk.
+    const std::string* m_name{};
+    std::unique_ptr<std::string> m_own_name{};
+    // The pool m_name was interned into, or nullptr if it's m_own_name.
+    detail::StringPool* m_name_pool{};
+    // May contain nullptr holes left by remove(); iterate live_children() instead.
     std::vector<std::unique_ptr<Object>> m_children{};
+    std::unique_ptr<ChildIndex> m_child_index{};
+    std::unique_ptr<ChildBuckets> m_child_buckets{};
+
+    struct DerivedType {
+        uint32_t kind;
+        size_t count;
+        Object* type;
+    };
+
+    // The Reference, Pointer and Array types Type::ref(), ptr() and array_() made from types this object owns. They're
+    // owned here rather than in m_children so they stay out of lookups and generation, and are found by their base
+    // type, kind and count instead of by name. A base type's entries are dropped once it's removed or destroyed (the
+    // types made from it stay owned here, since others may still use them). Only allocated once one is made.
+    struct DerivedTypes {
+        std::vector<std::unique_ptr<Object>> owned{};
+        std::unordered_map<const Object*, std::vector<DerivedType>> index{};
+    };
+
+    std::unique_ptr<DerivedTypes> m_derived_types{};
     std::vector<std::string> m_metadata{};
     std::string m_comment{};
 
     bool m_skip_generation{};
+
+    // What this object allocates its own containers from: the arena it was allocated from itself, since it keeps that
+    // one alive, or else the heap. Never the arena of an Sdk it's merely part of, which it may outlive.
+    std::pmr::memory_resource* resource() const {
+        return m_home_arena != nullptr ? m_home_arena : std::pmr::get_default_resource();
+    }
+
+    // Whether this object is one of its owner's children (rather than a derived type it owns).
+    bool is_child() const {
+        return m_owner != nullptr && m_slot < m_owner->m_children.size() && m_owner->m_children[m_slot].get() == this;
+    }
+
+    void build_child_index();
+    // The index's entry for name, added if there isn't one yet.
+    std::pmr::vector<Object*>& child_index_entry(std::string_view name);
+    void index_child(Object* child);
+    void unindex_child(Object* child);
+
+    std::span<Object* const> child_bucket(detail::Bucket bucket) const {
+        if (m_child_buckets == nullptr) {
+            return {};
+        }
+
+        return m_child_buckets->objects[bucket];
+    }
+
+    void bucket_child(Object* child);
+    void unbucket_child(Object* child);
+    // Removes the holes and the children that are no longer ours from a bucket.
+    void compact_bucket(detail::Bucket bucket);
+
+    // Refreshes the cached owners of this object and its children after it was added to or removed from an owner.
+    // Names are moved into the new Sdk's string pool, or given back to the objects if they no longer belong to one.
+    void relink();
+
+    auto live_children() const {
+        return m_children | std::views::filter([](const auto& child) { return child != nullptr; }) |
+               std::views::transform([](const auto& child) { return child.get(); });
+    }
+
+    bool has_children() const { return m_children.size() > m_holes; }
+
+    // Finishes removing children that have already been moved out of m_children.
+    void children_removed(std::vector<std::unique_ptr<Object>>& removed);
+    void compact_children();
+
+    // Invalidates the Sdk's tree numbering after a child was added to or removed from this object.
+    void structure_changed();
+
+    // Invalidates every cached Struct::vtable() in the Sdk after a virtual function or parent changed.
+    void vtables_changed();
+
+    // Invalidates the Sdk's dependency graph after a type referenced by this object changed.
+    void dependencies_changed();
+
+    // Drops the cached paths and qualified names of this object and its children.
+    void reset_name_caches();
+
+    NameCache& name_cache() const;
+};
+
+namespace detail {
+// Walks up the owner chain yielding only the owners of the correct type.
+template <typename T> class OwnerView : public std::ranges::view_interface<OwnerView<T>> {
+public:
+    class Iterator {
+    public:
+        using value_type = T*;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+        explicit Iterator(const Object* owner) : m_owner{skip(owner)} {}
+
+        T* operator*() const { return (T*)m_owner; }
+
+        Iterator& operator++() {
+            m_owner = skip(m_owner->direct_owner());
+            return *this;
+        }
+        Iterator operator++(int) {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+
+        bool operator==(const Iterator& other) const = default;
+        bool operator==(std::default_sentinel_t) const { return m_owner == nullptr; }
+
+    private:
+        const Object* m_owner{};
+
+        static const Object* skip(const Object* owner) {
+            while (owner != nullptr && !owner->template is_a<T>()) {
+                owner = owner->direct_owner();
+            }
+
+            return owner;
+        }
+    };
+
+    OwnerView() = default;
+    explicit OwnerView(const Object* first) : m_first{first} {}
+
+    Iterator begin() const { return Iterator{m_first}; }
+    std::default_sentinel_t end() const { return {}; }
+
+private:
+    const Object* m_first{};
 };
+} // namespace detail
 } // namespace sdkgenny
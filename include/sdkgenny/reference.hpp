@@ -10,6 +10,7 @@ public:
     auto to() const { return m_to; }
     auto to(Type* to) {
         m_to = to;
+        dependencies_changed();
         return this;
     }
 
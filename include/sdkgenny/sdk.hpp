@@ -3,9 +3,11 @@
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <memory_resource>
 #include <set>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <sdkgenny/enum.hpp>
@@ -19,9 +21,18 @@ namespace sdkgenny {
 class Sdk : public Object {
 public:
     Sdk();
+    ~Sdk() override;
 
     auto global_ns() const { return m_global_ns.get(); }
 
+    // Every object created within this Sdk is allocated from this arena, which is released once both the Sdk and the
+    // last of those objects are gone.
+    detail::Arena* arena() const { return m_arena.get(); }
+
+    // The names of every object within this Sdk are interned here so they are stored once and compare by address. It
+    // lives in the arena, so it's there for as long as any object allocated from it.
+    detail::StringPool* string_pool() const { return m_arena->string_pool(); }
+
     auto preamble(std::string_view preamble) {
         m_preamble = preamble;
         return this;
@@ -40,7 +51,22 @@ public:
         return this;
     }
 
-    void generate(const std::filesystem::path& sdk_path) const;
+    // Writes a header (and a source file when there are procedures) for every enum and struct, and lists them in
+    // file_list.txt. The files are rendered and written on jobs threads (0 uses one per core), with the same output as
+    // with 1.
+    void generate(const std::filesystem::path& sdk_path, size_t jobs = 1) const;
+
+    // Validates the layout of every struct in this Sdk (see Struct::validate_layout()).
+    std::vector<Struct::LayoutIssue> validate_layouts() const;
+
+    // Reflows (see Struct::reflow()) the edited structs and then, dependencies first, only those embedding or deriving
+    // from a struct whose layout changed. Returns the structs whose layout changed in that order.
+    std::vector<Struct*> reflow(const std::vector<Struct*>& edited);
+
+    // Computes and caches the size and vtable of every struct and array up front. Types are resolved level by level,
+    // each after everything it embeds or derives from, with the types of a level split across jobs threads (0 uses one
+    // per core). With 1 job, the default like generate()'s, it's the same work done serially in a fixed order.
+    void resolve_layouts(size_t jobs = 1) const;
 
     const auto& header_extension() const { return m_header_extension; }
     auto header_extension(std::string_view ext) {
@@ -69,7 +95,19 @@ public:
     }
 
 protected:
-    std::unique_ptr<Namespace> m_global_ns{std::make_unique<Namespace>("")};
+    friend class Object;
+    friend class Type;
+    friend class Struct;
+
+    // Lets objects skip unlinking themselves from each other when they're all being destroyed together.
+    bool m_is_being_destroyed{};
+    // Set once a type of ours may be size linked to one outside of us (one removed from us or made by us and never
+    // added), which has to be unlinked before we're destroyed.
+    bool m_has_foreign_size_links{};
+
+    // Our reference to the arena. Declared before m_global_ns so it's released after everything we own.
+    std::unique_ptr<detail::Arena, detail::Arena::Release> m_arena{detail::Arena::create()};
+    std::unique_ptr<Namespace> m_global_ns{new (m_arena.get()) Namespace{""}};
     std::string m_preamble{};
     std::string m_postamble{};
     std::set<std::string> m_includes{};
@@ -79,17 +117,71 @@ protected:
     std::string m_source_extension{".cpp"};
     bool m_generate_namespaces{true};
 
-    void generate_namespace(const std::filesystem::path& sdk_path, Namespace* ns) const;
+    // Bumped whenever an object is added or removed. The tree is only renumbered once it's stale and walking up owner
+    // chains has cost about as much as renumbering would, so interleaving changes and queries stays linear.
+    uint64_t m_structure_revision{};
+    mutable uint64_t m_numbered_revision{~0ull};
+    mutable size_t m_numbered_count{};
+    mutable size_t m_stale_walk_cost{};
+
+    // Bumped whenever a virtual function is added, removed or moved to another slot, or a struct gains a parent.
+    uint64_t m_vtable_revision{};
+
+    // Bumped whenever an object starts referencing a different type. The dependency graph is rebuilt once this or the
+    // structure revision moves on.
+    uint64_t m_dependency_revision{};
+    mutable Struct::DependencyGraph m_dependency_graph{};
+    mutable uint64_t m_graph_structure_revision{~0ull};
+    mutable uint64_t m_graph_dependency_revision{~0ull};
+
+    void build_dependency_graph(Object* obj) const;
+
+    bool dependency_graph_is_current() const {
+        return m_graph_structure_revision == m_structure_revision &&
+               m_graph_dependency_revision == m_dependency_revision;
+    }
 
-    template <typename T> void generate_header(const std::filesystem::path& sdk_path, T* obj) const {
+    // Appends the types whose size is derived from type, directly or not, and then type itself.
+    static void collect_size_dependents(Type* type, std::unordered_set<Type*>& visited, std::vector<Type*>& order);
+
+    // Marks the types layout_level() is still working out in level_of.
+    static constexpr auto IN_PROGRESS = ~size_t{};
+
+    // Which level of resolve_layouts() type belongs in: 0 if its size depends on no other type, otherwise one more than
+    // the highest level of those it does depend on. Adds type and what it depends on to levels.
+    static size_t layout_level(
+        Type* type, std::unordered_map<Type*, size_t>& level_of, std::vector<std::vector<Type*>>& levels);
+    void collect_layout_levels(
+        Object* obj, std::unordered_map<Type*, size_t>& level_of, std::vector<std::vector<Type*>>& levels) const;
+
+    // The dependencies of every struct in this Sdk, keyed by struct.
+    const Struct::DependencyGraph& dependency_graph() const;
+
+    // Whether owner owns obj, directly or not. Both must belong to this Sdk (or owner may be the Sdk itself).
+    bool is_owned_by(const Object* obj, const Object* owner) const;
+    void renumber() const;
+    void number(const Object* obj, uint32_t& counter) const;
+
+    // Unlinks the types within obj from the types they're size linked to outside of this Sdk.
+    void unlink_foreign_size_links(Object* obj);
+
+    // The enums and structs to generate, in the order they're listed in file_list.txt.
+    void collect_generated(Namespace* ns, std::vector<Object*>& objects) const;
+
+    // Fills every cache generation reads lazily (names, paths, sizes, vtables, dependencies, numbering) so generating
+    // on several threads doesn't write to anything shared between files.
+    void prepare_generation(size_t jobs) const;
+    void prepare_generation(const Object* obj) const;
+
+    // The directories the headers and sources are written to must exist already.
+    template <typename T>
+    void generate_header(const std::filesystem::path& sdk_path, T* obj, std::ostream& file_list) const {
         if (obj->skip_generation()) {
             return;
         }
 
         auto obj_inc_path = sdk_path / (obj->path() += m_header_extension);
-        std::ofstream file_list{sdk_path / "file_list.txt", std::ios::app};
         file_list << "\"" << obj_inc_path.string() << "\" \\\n";
-        std::filesystem::create_directories(obj_inc_path.parent_path());
         std::ofstream os{obj_inc_path};
 
         if (!m_preamble.empty()) {
@@ -115,16 +207,16 @@ protected:
         std::unordered_set<Type*> types_to_forward_decl{};
         std::set<std::filesystem::path> includes{};
 
-        if (auto s = dynamic_cast<Struct*>(obj)) {
+        if (auto s = obj->template as<Struct>()) {
             auto deps = s->dependencies();
-            types_to_include = deps.hard;
-            types_to_forward_decl = deps.soft;
+            types_to_include = std::move(deps.hard);
+            types_to_forward_decl = std::move(deps.soft);
         }
 
         for (auto&& ty : types_to_include) {
             // Instantiated template types don't have their own header.
             // Include the template definition header and the instantiation's deps.
-            if (auto inst = dynamic_cast<Struct*>(ty); inst && inst->is_template_instance()) {
+            if (auto inst = ty->as<Struct>(); inst && inst->is_template_instance()) {
                 // Skip self-includes: a self-referential template (e.g. Node<T>* inside Node)
                 // would resolve template_source() back to the struct being generated.
                 if (static_cast<Object*>(inst->template_source()) != static_cast<Object*>(obj)) {
@@ -133,7 +225,7 @@ protected:
 
                 auto inst_deps = inst->dependencies();
                 for (auto&& dep : inst_deps.hard) {
-                    if (auto dep_inst = dynamic_cast<Struct*>(dep); dep_inst && dep_inst->is_template_instance()) {
+                    if (auto dep_inst = dep->as<Struct>(); dep_inst && dep_inst->is_template_instance()) {
                         if (static_cast<Object*>(dep_inst->template_source()) != static_cast<Object*>(obj)) {
                             includes.emplace(dep_inst->template_source()->path() += m_header_extension);
                         }
@@ -142,7 +234,7 @@ protected:
                     }
                 }
                 for (auto&& dep : inst_deps.soft) {
-                    if (auto dep_inst = dynamic_cast<Struct*>(dep); dep_inst && dep_inst->is_template_instance()) {
+                    if (auto dep_inst = dep->as<Struct>(); dep_inst && dep_inst->is_template_instance()) {
                         if (static_cast<Object*>(dep_inst->template_source()) != static_cast<Object*>(obj)) {
                             includes.emplace(dep_inst->template_source()->path() += m_header_extension);
                         }
@@ -158,7 +250,7 @@ protected:
         // Done before emitting includes so they're grouped and deduped.
         std::unordered_set<Type*> fwd_decl_filtered{};
         for (auto&& type : types_to_forward_decl) {
-            if (auto inst = dynamic_cast<Struct*>(type); inst && inst->is_template_instance()) {
+            if (auto inst = type->as<Struct>(); inst && inst->is_template_instance()) {
                 if (static_cast<Object*>(inst->template_source()) != static_cast<Object*>(obj)) {
                     includes.emplace(inst->template_source()->path() += m_header_extension);
                 }
@@ -173,66 +265,36 @@ protected:
 
         for (auto&& type : fwd_decl_filtered) {
 
-            auto owners = type->owners<Namespace>();
-
-            if (owners.size() > 1 && m_generate_namespaces) {
-                std::reverse(owners.begin(), owners.end());
+            auto ns = type->owner<Namespace>();
+            auto in_namespace = m_generate_namespaces && ns != nullptr && ns->owner<Namespace>() != nullptr;
 
-                os << "namespace ";
-
-                for (auto&& owner : owners) {
-                    if (owner->usable_name().empty()) {
-                        continue;
-                    }
-
-                    os << owner->usable_name();
-
-                    if (owner != owners.back()) {
-                        os << "::";
-                    }
-                }
-
-                os << " {\n";
+            if (in_namespace) {
+                os << "namespace " << ns->qualified_name() << " {\n";
             }
 
-            if (auto s = dynamic_cast<Struct*>(type)) {
+            if (auto s = type->as<Struct>()) {
                 s->generate_forward_decl(os);
-            } else if (auto e = dynamic_cast<Enum*>(type)) {
+            } else if (auto e = type->as<Enum>()) {
                 e->generate_forward_decl(os);
             }
 
-            if (owners.size() > 1 && m_generate_namespaces) {
+            if (in_namespace) {
                 os << "}\n";
             }
         }
 
-        auto owners = obj->template owners<Namespace>();
-
-        if (owners.size() > 1 && m_generate_namespaces) {
-            std::reverse(owners.begin(), owners.end());
-
-            os << "namespace ";
+        auto ns = obj->template owner<Namespace>();
+        auto in_namespace = m_generate_namespaces && ns != nullptr && ns->template owner<Namespace>() != nullptr;
 
-            for (auto&& owner : owners) {
-                if (owner->usable_name().empty()) {
-                    continue;
-                }
-
-                os << owner->usable_name();
-
-                if (owner != owners.back()) {
-                    os << "::";
-                }
-            }
-
-            os << " {\n";
+        if (in_namespace) {
+            os << "namespace " << ns->qualified_name() << " {\n";
         }
 
         os << "#pragma pack(push, 1)\n";
         obj->generate(os);
         os << "#pragma pack(pop)\n";
 
-        if (owners.size() > 1 && m_generate_namespaces) {
+        if (in_namespace) {
             os << "}\n";
         }
 
@@ -246,7 +308,8 @@ protected:
         }
     }
 
-    template <typename T> void generate_source(const std::filesystem::path& sdk_path, T* obj) const {
+    template <typename T>
+    void generate_source(const std::filesystem::path& sdk_path, T* obj, std::ostream& file_list) const {
         if (obj->skip_generation()) {
             return;
         }
@@ -274,10 +337,8 @@ protected:
         }
 
         auto obj_src_path = sdk_path / (obj->path() += m_source_extension);
-        std::ofstream file_list{sdk_path / "file_list.txt", std::ios::app};
         file_list << "\"" << obj_src_path.string() << "\" \\\n";
 
-        std::filesystem::create_directories(obj_src_path.parent_path());
         std::ofstream os{obj_src_path};
 
         if (!m_preamble.empty()) {
@@ -291,10 +352,10 @@ protected:
 
         std::unordered_set<Type*> types_to_include{};
 
-        if (auto s = dynamic_cast<Struct*>(obj)) {
+        if (auto s = obj->template as<Struct>()) {
             auto deps = s->dependencies();
-            types_to_include = deps.hard;
-            types_to_include.merge(deps.soft);
+            types_to_include = std::move(deps.hard);
+            types_to_include.insert(deps.soft.begin(), deps.soft.end());
             types_to_include.emplace(s);
         }
 
@@ -308,7 +369,7 @@ protected:
         for (auto&& ty : types_to_include) {
             // Mirror generate_header: template instances don't have their own header;
             // include the template definition header instead (Comment 19).
-            if (auto inst = dynamic_cast<Struct*>(ty); inst && inst->is_template_instance()) {
+            if (auto inst = ty->as<Struct>(); inst && inst->is_template_instance()) {
                 if (static_cast<Object*>(inst->template_source()) != static_cast<Object*>(obj)) {
                     includes.emplace(inst->template_source()->path() += m_header_extension);
                 }
@@ -339,13 +400,6 @@ protected:
             }
         }
     }
-
-    template <typename T> void generate(const std::filesystem::path& sdk_path, Namespace* ns) const {
-        for (auto&& obj : ns->get_all<T>()) {
-            generate_header(sdk_path, obj);
-            generate_source(sdk_path, obj);
-        }
-    }
 };
 
 } // namespace sdkgenny
\ No newline at end of file
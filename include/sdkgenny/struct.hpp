@@ -2,9 +2,16 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
+#include <memory_resource>
+#include <optional>
 #include <ostream>
+#include <ranges>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <sdkgenny/type.hpp>
@@ -31,6 +38,92 @@ public:
     // while constructing the map.
     std::map<uintptr_t, Variable*> bitfield(uintptr_t offset, Variable* ignore = nullptr) const;
 
+    struct LayoutIssue {
+        enum Kind {
+            // Two fields share bytes (bitfields sharing a storage unit of the same type don't count).
+            OVERLAP,
+            // A field ends past the struct's explicit size().
+            OUT_OF_BOUNDS,
+            // A bitfield doesn't fit in its type, shares bits with another one, or shares its storage unit with a
+            // bitfield of a different type.
+            BITFIELD,
+            // A field starts within the parents (or the vtable pointer) of the struct.
+            PARENT_OVERLAP,
+        };
+
+        Kind kind{};
+        const Struct* struct_{};
+        Variable* var{};
+        // The field var collides with, if any.
+        Variable* other{};
+        std::string message{};
+    };
+
+    struct FieldLocation {
+        Variable* var{};
+        // Where var starts, relative to the struct field_at() was called on.
+        uintptr_t offset{};
+        // When var is an array, the index of the element holding the offset (one per dimension, outermost first).
+        std::vector<size_t> indices{};
+        // The bits of the storage unit var occupies when it's a bitfield.
+        uintptr_t bit_offset{};
+        size_t bit_size{};
+    };
+
+    // What lives at the given offset: the chain of fields leading to it, outermost first, resolved through parents,
+    // by-value struct fields and array elements. Where fields overlap, the one starting closest to the offset wins and
+    // then the latest declared one, so a bitfield storage unit resolves to its latest declared bitfield (see
+    // bitfield() for the rest). Empty if the offset is padding or past the end.
+    std::vector<FieldLocation> field_at(uintptr_t offset) const;
+
+    // Formats a field_at() chain like "ns::Base::m_transform.m_pos[2].y".
+    static std::string field_path(const std::vector<FieldLocation>& chain);
+
+    // A field path resolved against the layout once, so following it from an address is only additions and reads.
+    struct FieldPlan {
+        // Offsets to add in turn. Between two of them, the address reached so far holds a pointer that is read.
+        std::vector<uintptr_t> offsets{};
+        // The field the path ends at.
+        Variable* var{};
+
+        // Follows the plan from the address of a struct in this process. Returns 0 when a pointer along the way is
+        // null, or for an empty plan (one not made by compile_path()).
+        uintptr_t resolve(uintptr_t address) const {
+            if (offsets.empty()) {
+                return 0;
+            }
+
+            address += offsets.front();
+
+            for (size_t i = 1; i < offsets.size(); ++i) {
+                address = *reinterpret_cast<const uintptr_t*>(address);
+
+                if (address == 0) {
+                    return 0;
+                }
+
+                address += offsets[i];
+            }
+
+            return address;
+        }
+    };
+
+    // Compiles a path like "player.inventory.items[3].count" starting at a field of this struct (or its parents).
+    // Fields of by-value structs and array elements fold into a constant offset, while "." or "->" through a
+    // pointer or reference, and indexing one, read it. Empty if a name isn't found, an index is out of bounds or the
+    // path doesn't parse.
+    std::optional<FieldPlan> compile_path(std::string_view path) const;
+
+    // Appends the problems with the layout of this struct's fields to issues. Fields without a size are skipped like
+    // generation skips them, and so are templates and their instances since their offsets depend on the arguments.
+    void validate_layout(std::vector<LayoutIssue>& issues) const;
+
+    // Recomputes the offsets set by append(), bit_append() and "+ delta" in declaration order, as if the fields were
+    // declared again with their current types. Returns whether any offset moved or the size differs from what it was
+    // before the edits since the last reflow. See Sdk::reflow() to also update the structs depending on this one.
+    bool reflow();
+
     Struct* struct_(std::string_view name);
     Class* class_(std::string_view name);
     Enum* enum_(std::string_view name);
@@ -51,13 +144,21 @@ public:
     bool is_template_instance() const { return m_template_source != nullptr; }
     // The template definition this struct was instantiated from, or nullptr.
     Struct* template_source() const { return m_template_source; }
+    // The arguments this struct was instantiated with, empty if it isn't an instance.
+    const std::vector<Type*>& template_arguments() const { return m_template_args; }
 
     const std::vector<Struct*>& parents() const;
     Struct* parent(Struct* parent);
 
+    // One entry per slot of this struct's virtual function table, including the slots inherited from its parents (whose
+    // tables are laid out one after another). Each entry is the virtual function occupying the slot, either declared
+    // here or inherited, or nullptr. Cached until a virtual function or parent changes anywhere in the Sdk.
+    const std::vector<VirtualFunction*>& vtable() const;
+
     size_t size() const override;
     auto size(int size) {
         m_size = size;
+        size_changed();
         return this;
     }
 
@@ -69,6 +170,11 @@ public:
         std::unordered_set<Type*> soft{};
     };
 
+    using DependencyGraph = std::unordered_map<const Struct*, Dependencies>;
+
+    // The types this struct needs to be defined (hard) or declared (soft) before it. Copied from the Sdk's dependency
+    // graph while it's up to date (generate() builds it for every struct in one pass), otherwise computed for this
+    // struct alone so a query after an edit doesn't rebuild the graph.
     Dependencies dependencies();
 
     template <typename T> T* find_in_parents(std::string_view name) {
@@ -82,39 +188,146 @@ public:
     }
 
 protected:
+    friend class Object;
+    friend class Sdk;
+    friend class Type;
+    friend class Variable;
+
+    // Orders variables by offset, then bit offset, then declaration order, so the variables sharing a storage unit form
+    // a contiguous group sorted the way bitfields are laid out. Also compares against a bare offset so a group can be
+    // looked up.
+    struct LayoutOrder {
+        using is_transparent = void;
+
+        bool operator()(const Variable* a, const Variable* b) const;
+        bool operator()(const Variable* a, uintptr_t offset) const;
+        bool operator()(uintptr_t offset, const Variable* b) const;
+    };
+
+    using Layout = std::pmr::set<Variable*, LayoutOrder>;
+
     std::vector<Struct*> m_parents{};
     std::vector<TemplateParameter*> m_template_params{};
     Struct* m_template_source{};
+    std::vector<Type*> m_template_args{};
+
+    struct TypeListHash {
+        size_t operator()(const std::vector<Type*>& types) const;
+    };
+
+    // The live instances of this template, keyed by their arguments. An instance leaves it once it's removed from its
+    // owner or renamed, so instantiate() goes back to looking it up by name.
+    std::unordered_map<std::vector<Type*>, Struct*, TypeListHash> m_instances{};
 
-    int vtable_size() const;
+    // Drops this instance from its template's m_instances.
+    void forget_instance();
+
+    // Every variable of this struct in LayoutOrder, kept up to date as variables are added, removed or moved. Only
+    // allocated (from resource()) once a variable is added.
+    std::unique_ptr<Layout> m_layout{};
+
+    // The variables that take up space ordered by offset, with how far the furthest reaching of them up to each one
+    // ends, so field_at() finds every field covering an offset even when they overlap. Built on demand and dropped
+    // along with the cached size, which goes whenever a field is added, removed, moved or resized.
+    struct FieldIndex {
+        std::vector<uintptr_t> offsets{};
+        std::vector<uintptr_t> reach{};
+        std::vector<Variable*> vars{};
+    };
+
+    mutable std::unique_ptr<FieldIndex> m_field_index{};
+
+    const FieldIndex& field_index() const;
+
+    mutable std::vector<VirtualFunction*> m_vtable{};
+    mutable uint64_t m_vtable_revision{~0ull};
+
+    void layout_insert(Variable* var);
+    void layout_erase(Variable* var);
+
+    // Applies change (which moves var to a new offset or bit offset) while keeping m_layout ordered.
+    template <typename F> void relayout(Variable* var, F&& change) {
+        auto indexed = m_layout != nullptr && layout_contains(var);
+
+        if (indexed) {
+            layout_erase(var);
+        }
+
+        change();
+
+        if (indexed) {
+            layout_insert(var);
+        }
+    }
+
+    bool layout_contains(const Variable* var) const;
+
+    // The variables at the given offset, ordered by bit offset then declaration order.
+    std::ranges::subrange<Layout::const_iterator> layout_group(uintptr_t offset) const;
+
+    // The latest declared variable in [first, last), ignoring the given variable.
+    static Variable* latest_declared(Layout::const_iterator first, Layout::const_iterator last, const Variable* ignore);
+
+    // The variable with the highest offset (the latest declared one on ties), ignoring the given variable.
+    Variable* layout_tail(const Variable* ignore = nullptr) const;
+
+    // The variable with the highest bit offset (the latest declared one on ties) in the storage unit at the given
+    // offset, ignoring the given variable.
+    Variable* bitfield_tail(uintptr_t offset, const Variable* ignore = nullptr) const;
 
     template <typename T, typename... TArgs> T* find_or_add_unique(std::string_view name, TArgs... args) {
         if (auto search = find<T>(name); search != nullptr) {
             return search;
         }
 
-        std::string fixed_name{};
-        auto num_collisions = 0;
-        auto has_collision = false;
+        if (find_in_parents<Object>(name) == nullptr) {
+            return add(make<T>(name, args...));
+        }
 
-        do {
-            has_collision = false;
+        // The lowest suffix none of the parents use. Each parent jumps straight past the suffixes it uses itself, so
+        // this settles after a pass or two.
+        size_t suffix = 0;
 
-            if (find_in_parents<Object>(fixed_name.empty() ? name : fixed_name) != nullptr) {
-                fixed_name = name;
-                fixed_name += std::to_string(num_collisions);
-                ++num_collisions;
-                has_collision = true;
-            }
-        } while (has_collision);
+        for (auto settled = false; !settled;) {
+            settled = true;
 
-        if (num_collisions == 0) {
-            return add(std::make_unique<T>(name, args...));
+            for (auto&& parent : m_parents) {
+                if (auto next = parent->free_suffix(name, suffix); next != suffix) {
+                    suffix = next;
+                    settled = false;
+                }
+            }
         }
 
-        return add(std::make_unique<T>(fixed_name, args...));
+        std::string fixed_name{name};
+        fixed_name += std::to_string(suffix);
+
+        return add(make<T>(fixed_name, args...));
     }
 
+    // Per base name, how many suffixes starting from 0 children of this struct are known to use as "<base><suffix>".
+    // Adding children can only make it an underestimate, so it's just dropped when a child is removed or renamed.
+    std::unordered_map<std::string, size_t, detail::StringHash, std::equal_to<>> m_used_suffixes{};
+
+    // Called once a field stops using type, to unlink our size from it unless a parent or another field still uses it.
+    void size_dependency_released(Type* type);
+
+    // The size cached before the first edit since the last reflow() dropped it, if one was cached.
+    size_t m_size_before_edits{UNKNOWN_SIZE};
+
+    // The lowest suffix from the given one up for which this struct has no child named "<base><suffix>".
+    size_t free_suffix(std::string_view base, size_t from);
+    void names_released() { m_used_suffixes.clear(); }
+
+    // field_at() for a struct starting at base within the one field_at() was called on.
+    void resolve_field(uintptr_t offset, uintptr_t base, std::vector<FieldLocation>& chain) const;
+
+    // The field called name in this struct or one of its parents, with base set to the offset of the one declaring it.
+    Variable* find_field(std::string_view name, uintptr_t& base) const;
+
+    // Computes dependencies(), taking those of nested structs from graph when they're already in it.
+    Dependencies collect_dependencies(const DependencyGraph& graph);
+
     void generate_inheritance(std::ostream& os) const;
     void generate_bitfield(std::ostream& os, uintptr_t offset) const;
     void generate_internal(std::ostream& os) const;
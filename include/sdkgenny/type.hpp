@@ -1,8 +1,10 @@
 #pragma once
 
 #include <cstddef>
+#include <memory_resource>
 #include <ostream>
 #include <string_view>
+#include <vector>
 
 #include <sdkgenny/typename.hpp>
 
@@ -14,20 +16,54 @@ class Array;
 class Type : public Typename {
 public:
     explicit Type(std::string_view name);
+    ~Type() override;
 
     virtual void generate_variable_postamble(std::ostream& os [[maybe_unused]]) const {}
 
     virtual size_t size() const { return m_size; }
     auto size(size_t size) {
         m_size = size;
+        size_changed();
         return this;
     }
 
+    // Types whose size is derived from this one (structs and arrays that embed it by value, enums based on it) register
+    // themselves here so the sizes they cache are dropped whenever this type's size changes.
+    void add_size_dependent(Type* dependent);
+    // Undoes add_size_dependent() once dependent no longer embeds or derives from this type.
+    void remove_size_dependent(Type* dependent);
+
+    // Drops the cached size of this type and of every type whose size is derived from it.
+    void size_changed();
+
     Reference* ref();
     Pointer* ptr();
     Array* array_(size_t count = 0);
 
 protected:
+    friend class Sdk;
+
+    static constexpr auto UNKNOWN_SIZE = ~size_t{};
+
+    struct SizeLinks {
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
+        explicit SizeLinks(const allocator_type& alloc) : dependencies{alloc}, dependents{alloc} {}
+
+        std::pmr::vector<Type*> dependencies;
+        std::pmr::vector<Type*> dependents;
+    };
+
     size_t m_size{};
+    // Only used by the types that derive their size from others (structs and arrays).
+    mutable size_t m_cached_size{UNKNOWN_SIZE};
+    // Allocated from resource() once this type is linked to another.
+    SizeLinks* m_size_links{};
+
+    SizeLinks& size_links();
+
+    // Finds the Reference, Pointer or Array made from this type (with the given count) among our owner's derived types,
+    // making it if there isn't one yet.
+    template <typename T> T* derived(size_t count);
 };
 } // namespace sdkgenny
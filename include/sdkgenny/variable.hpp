@@ -11,27 +11,20 @@
 namespace sdkgenny {
 class Variable : public Object {
 public:
-    explicit Variable(std::string_view name) : Object{name} {}
+    explicit Variable(std::string_view name) : Object{name} { m_kind |= detail::KIND_VARIABLE; }
 
     auto type() const { return m_type; }
-    auto type(Type* type) {
-        m_type = type;
-        return this;
-    }
+    Variable* type(Type* type);
 
     // Helper that recurses though owners to find the correct type.
-    auto type(std::string_view name) {
-        m_type = find_in_owners_or_add<Type>(name);
-        return this;
-    }
+    auto type(std::string_view name) { return type(find_in_owners_or_add<Type>(name)); }
 
     auto offset() const { return m_offset; }
-    auto offset(uintptr_t offset) {
-        m_offset = offset;
-        m_offset_is_explicit = true;
-        return this;
-    }
+    Variable* offset(uintptr_t offset);
     auto offset_is_explicit() const { return m_offset_is_explicit; }
+    // Whether the offset (or bit offset) was last set by append() (or bit_append()), so Struct::reflow() recomputes it.
+    auto offset_is_appended() const { return m_offset_is_appended; }
+    auto bit_offset_is_appended() const { return m_bit_offset_is_appended; }
 
     auto delta() const { return m_delta; }
     auto delta(uintptr_t d) {
@@ -55,11 +48,7 @@ public:
     }
     auto bit_size() const { return m_bit_size; }
 
-    auto bit_offset(uintptr_t offset) {
-        // assert(offset < m_type->size() * CHAR_BIT);
-        m_bit_offset = offset;
-        return this;
-    }
+    Variable* bit_offset(uintptr_t offset);
     auto bit_offset() const { return m_bit_offset; }
 
     auto is_bitfield() const { return m_bit_size != 0; }
@@ -70,12 +59,20 @@ public:
     virtual void generate(std::ostream& os) const;
 
 protected:
+    friend class Struct;
+
     Type* m_type{};
     uintptr_t m_offset{};
     bool m_offset_is_explicit{};
+    bool m_offset_is_appended{};
     uintptr_t m_delta{};
     bool m_has_delta{};
     size_t m_bit_size{};
     uintptr_t m_bit_offset{};
+    bool m_bit_offset_is_appended{};
+
+    // Where append() and bit_append() would place this variable given the others currently laid out in struct_.
+    uintptr_t appended_offset(const Struct* struct_) const;
+    uintptr_t appended_bit_offset(const Struct* struct_) const;
 };
 } // namespace sdkgenny
\ No newline at end of file
@@ -10,10 +10,7 @@ public:
     explicit VirtualFunction(std::string_view name);
 
     auto vtable_index() const { return m_vtable_index; }
-    auto vtable_index(uint32_t vtable_index) {
-        m_vtable_index = vtable_index;
-        return this;
-    }
+    VirtualFunction* vtable_index(uint32_t vtable_index);
 
     void generate(std::ostream& os) const override;
 
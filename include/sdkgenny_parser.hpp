@@ -209,7 +209,7 @@ struct State {
     template <typename T> T* lookup(const std::vector<std::string>& names) {
         std::function<T*(Object*, int)> search = [&](Object* parent, int i) -> T* {
             if (names.empty()) {
-                return dynamic_cast<T*>(parents.front());
+                return parents.front()->template as<T>();
             } else if (i >= names.size()) {
                 return nullptr;
             }
@@ -225,7 +225,7 @@ struct State {
 
             // We found the name. Is this the type we were looking for?
             if (i == names.size() - 1) {
-                return dynamic_cast<T*>(child);
+                return child->template as<T>();
             }
 
             return search(child, ++i);
@@ -333,7 +333,7 @@ template <> struct Action<NsNameList> {
 
 template <> struct Action<NsDecl> {
     template <typename Input> static void apply(const Input& in, State& s) {
-        if (auto cur_ns = dynamic_cast<Namespace*>(s.parents.back())) {
+        if (auto cur_ns = s.parents.back()->as<Namespace>()) {
             auto depth = 0;
 
             for (auto&& ns : s.ns) {
@@ -374,7 +374,7 @@ template <> struct Action<TypeName> {
 
 template <> struct Action<TypeDecl> {
     template <typename Input> static void apply(const Input& in, State& s) {
-        if (auto ns = dynamic_cast<Namespace*>(s.parents.back())) {
+        if (auto ns = s.parents.back()->as<Namespace>()) {
             auto type = ns->type(s.type_name);
 
             type->size(s.type_size);
@@ -407,13 +407,13 @@ template <> struct Action<EnumExpr> {
     template <typename Input> static void apply(const Input& in, State& s) {
         Enum* enum_{};
 
-        if (auto p = dynamic_cast<Namespace*>(s.parents.back())) {
+        if (auto p = s.parents.back()->as<Namespace>()) {
             if (s.enum_class) {
                 enum_ = p->enum_class(s.enum_name);
             } else {
                 enum_ = p->enum_(s.enum_name);
             }
-        } else if (auto p = dynamic_cast<Struct*>(s.parents.back())) {
+        } else if (auto p = s.parents.back()->as<Struct>()) {
             if (s.enum_class) {
                 enum_ = p->enum_class(s.enum_name);
             } else {
@@ -497,13 +497,13 @@ template <> struct Action<StructDecl> {
     template <typename Input> static void apply(const Input& in, State& s) {
         Struct* struct_{};
 
-        if (auto p = dynamic_cast<Namespace*>(s.parents.back())) {
+        if (auto p = s.parents.back()->as<Namespace>()) {
             if (s.struct_is_class) {
                 struct_ = p->class_(s.struct_name);
             } else {
                 struct_ = p->struct_(s.struct_name);
             }
-        } else if (auto p = dynamic_cast<Struct*>(s.parents.back())) {
+        } else if (auto p = s.parents.back()->as<Struct>()) {
             if (s.struct_is_class) {
                 struct_ = p->class_(s.struct_name);
             } else {
@@ -624,7 +624,7 @@ template <> struct Action<TemplateArgs> {
             throw parse_error{"Template arguments found but base type is null", in};
         }
 
-        auto struct_type = dynamic_cast<Struct*>(s.cur_type);
+        auto struct_type = s.cur_type->as<Struct>();
         if (struct_type == nullptr || !struct_type->is_template()) {
             throw parse_error{"Template arguments can only be applied to a template struct/class", in};
         }
@@ -712,7 +712,7 @@ template <> struct Action<VarDecl> {
 
         s.var_type_array_counts.clear();
 
-        if (auto struct_ = dynamic_cast<Struct*>(s.parents.back())) {
+        if (auto struct_ = s.parents.back()->as<Struct>()) {
             auto var = struct_->variable(s.var_name);
 
             var->type(s.cur_type);
@@ -805,7 +805,7 @@ template <> struct Action<FnVirtualIndex> {
 
 template <> struct Action<FnDecl> {
     template <typename Input> static void apply(const Input& in, State& s) {
-        if (auto struct_ = dynamic_cast<Struct*>(s.parents.back())) {
+        if (auto struct_ = s.parents.back()->as<Struct>()) {
             Function* fn{};
 
             if (s.fn_is_static) {
@@ -814,7 +814,7 @@ template <> struct Action<FnDecl> {
                 fn = struct_->virtual_function(s.fn_name);
 
                 if (s.fn_virtual_index) {
-                    dynamic_cast<VirtualFunction*>(fn)->vtable_index(*s.fn_virtual_index);
+                    fn->as<VirtualFunction>()->vtable_index(*s.fn_virtual_index);
                 }
             } else {
                 fn = struct_->function(s.fn_name);
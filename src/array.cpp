@@ -2,6 +2,7 @@
 
 namespace sdkgenny {
 Array::Array(std::string_view name) : Type{name} {
+    m_kind |= detail::KIND_ARRAY;
 }
 
 Array* Array::count(size_t count) {
@@ -16,20 +17,27 @@ Array* Array::count(size_t count) {
             tail = base.substr(first_brace);
         }
 
-        m_name = head + '[' + std::to_string(count) + ']' + tail;
+        name(head + '[' + std::to_string(count) + ']' + tail);
     }
 
-    m_count = count;
+    if (count != m_count) {
+        m_count = count;
+        size_changed();
+    }
 
     return this;
 }
 
 size_t Array::size() const {
+    if (m_cached_size != UNKNOWN_SIZE) {
+        return m_cached_size;
+    }
+
     if (m_of == nullptr) {
         return 0;
     }
 
-    return m_of->size() * m_count;
+    return m_cached_size = m_of->size() * m_count;
 }
 
 void Array::generate_typename_for(std::ostream& os, const Object* obj) const {
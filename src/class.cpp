@@ -3,6 +3,7 @@
 
 namespace sdkgenny {
 Class::Class(std::string_view name) : Struct{name} {
+    m_kind |= detail::KIND_CLASS;
 }
 
 void Class::generate_forward_decl(std::ostream& os) const {
@@ -35,7 +36,7 @@ void Class::generate(std::ostream& os) const {
     generate_inheritance(os);
     os << " {\n";
 
-    if (!m_children.empty()) {
+    if (has_children()) {
         os << "public:\n";
     }
 
@@ -4,10 +4,12 @@
 
 namespace sdkgenny {
 Constant::Constant(std::string_view name) : Object{name} {
+    m_kind |= detail::KIND_CONSTANT;
 }
 
 Constant* Constant::type(std::string_view name) {
     m_type = find_in_owners_or_add<Type>(name);
+    dependencies_changed();
     return this;
 }
 
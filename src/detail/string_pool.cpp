@@ -0,0 +1,24 @@
+#include <sdkgenny/detail/string_pool.hpp>
+
+namespace sdkgenny::detail {
+thread_local StringPool* StringPool::s_current{};
+
+StringPool::StringPool(std::pmr::memory_resource* resource) : m_strings{resource} {
+}
+
+const std::string& StringPool::intern(std::string_view str) {
+    if (auto search = m_strings.find(str); search != m_strings.end()) {
+        return *search;
+    }
+
+    return *m_strings.emplace(str).first;
+}
+
+const std::string* StringPool::find(std::string_view str) const {
+    if (auto search = m_strings.find(str); search != m_strings.end()) {
+        return &*search;
+    }
+
+    return nullptr;
+}
+} // namespace sdkgenny::detail
@@ -0,0 +1,148 @@
+#include <algorithm>
+
+#include <sdkgenny/detail/thread_pool.hpp>
+
+namespace sdkgenny::detail {
+static constexpr uint64_t pack(uint64_t begin, uint64_t end) {
+    return begin << 32 | end;
+}
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    m_shares = std::make_unique<Share[]>(threads);
+
+    for (size_t i = 1; i < threads; ++i) {
+        m_workers.emplace_back([this, i] {
+            uint64_t seen{};
+
+            while (true) {
+                {
+                    std::unique_lock lock{m_mutex};
+
+                    m_start.wait(lock, [&] { return m_stop || m_generation != seen; });
+
+                    if (m_stop) {
+                        return;
+                    }
+
+                    seen = m_generation;
+                }
+
+                work(i);
+
+                std::scoped_lock lock{m_mutex};
+
+                if (--m_busy == 0) {
+                    m_done.notify_one();
+                }
+            }
+        });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::scoped_lock lock{m_mutex};
+        m_stop = true;
+    }
+
+    m_start.notify_all();
+
+    for (auto&& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallel_for(size_t count, const std::function<void(size_t)>& fn) {
+    if (m_workers.empty() || count <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+
+        return;
+    }
+
+    m_fn = &fn;
+
+    // Shares hold 32 bit indices, so huge loops are run a few billion indices at a time.
+    for (m_base = 0; m_base < count; m_base += UINT32_MAX) {
+        auto chunk = std::min<size_t>(count - m_base, UINT32_MAX);
+        auto threads = size();
+
+        for (size_t i = 0; i < threads; ++i) {
+            m_shares[i].bounds.store(pack(chunk * i / threads, chunk * (i + 1) / threads), std::memory_order_relaxed);
+        }
+
+        {
+            std::scoped_lock lock{m_mutex};
+            m_busy = m_workers.size();
+            ++m_generation;
+        }
+
+        m_start.notify_all();
+        work(0);
+
+        std::unique_lock lock{m_mutex};
+
+        m_done.wait(lock, [&] { return m_busy == 0; });
+    }
+
+    m_fn = nullptr;
+
+    if (auto exception = std::exchange(m_exception, nullptr)) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void ThreadPool::work(size_t self) {
+    auto threads = size();
+    auto& own = m_shares[self].bounds;
+
+    while (true) {
+        // Take indices from the front of our own share, one at a time.
+        for (auto bounds = own.load(); (bounds >> 32) < (uint32_t)bounds;) {
+            if (own.compare_exchange_weak(bounds, bounds + pack(1, 0))) {
+                call(m_base + (bounds >> 32));
+            }
+        }
+
+        // Then steal the back half of whichever other share has indices left.
+        auto stolen = false;
+
+        for (size_t i = 1; i < threads && !stolen; ++i) {
+            auto& victim = m_shares[(self + i) % threads].bounds;
+
+            for (auto bounds = victim.load(); (bounds >> 32) < (uint32_t)bounds;) {
+                auto begin = bounds >> 32;
+                auto end = bounds & UINT32_MAX;
+                auto middle = begin + (end - begin) / 2;
+
+                if (victim.compare_exchange_weak(bounds, pack(begin, middle))) {
+                    own.store(pack(middle, end));
+                    stolen = true;
+                    break;
+                }
+            }
+        }
+
+        if (!stolen) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::call(size_t index) {
+    try {
+        (*m_fn)(index);
+    } catch (...) {
+        std::scoped_lock lock{m_mutex};
+
+        if (m_exception == nullptr) {
+            m_exception = std::current_exception();
+        }
+    }
+}
+} // namespace sdkgenny::detail
@@ -4,6 +4,7 @@
 
 namespace sdkgenny {
 Enum::Enum(std::string_view name) : Type{name} {
+    m_kind |= detail::KIND_ENUM;
 }
 
 Enum* Enum::value(std::string_view name, uint64_t value) {
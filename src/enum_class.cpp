@@ -2,6 +2,7 @@
 
 namespace sdkgenny {
 EnumClass::EnumClass(std::string_view name) : Enum{name} {
+    m_kind |= detail::KIND_ENUM_CLASS;
 }
 
 void EnumClass::generate_forward_decl(std::ostream& os) const {
@@ -6,6 +6,7 @@
 
 namespace sdkgenny {
 Function::Function(std::string_view name) : Object{name} {
+    m_kind |= detail::KIND_FUNCTION;
 }
 
 Parameter* Function::param(std::string_view name) {
@@ -40,7 +41,7 @@ void Function::generate_prototype_internal(std::ostream& os) const {
 
     auto is_first_param = true;
 
-    for (auto&& param : get_all<Parameter>()) {
+    for (auto&& param : child_view<Parameter>()) {
         if (is_first_param) {
             is_first_param = false;
         } else {
@@ -62,21 +63,9 @@ void Function::generate_procedure(std::ostream& os) const {
 
     os << " ";
 
-    std::vector<const Object*> owners{};
-
-    for (auto o = owner<Object>(); o != nullptr; o = o->owner<Object>()) {
-        // The global NS will have an empty name, at which point we stop.
-        if (o->usable_name().empty()) {
-            break;
-        }
-
-        owners.emplace_back(o);
-    }
-
-    std::reverse(owners.begin(), owners.end());
-
-    for (auto&& o : owners) {
-        os << o->usable_name() << "::";
+    // The global NS will have an empty name, at which point we stop.
+    if (auto o = direct_owner(); o != nullptr && !o->usable_name().empty()) {
+        os << o->qualified_name() << "::";
     }
 
     generate_prototype_internal(os);
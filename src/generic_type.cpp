@@ -2,11 +2,12 @@
 
 namespace sdkgenny {
 GenericType::GenericType(std::string_view name) : Type{name} {
+    m_kind |= detail::KIND_GENERIC_TYPE;
     usable_name = [this] {
         std::string name{};
         constexpr auto allowed_chars = "*&[]:<>, ";
 
-        for (auto&& c : m_name) {
+        for (auto&& c : *m_name) {
             if (!std::isalnum(c) && std::strchr(allowed_chars, c) == nullptr) {
                 name += '_';
             } else {
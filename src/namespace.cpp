@@ -9,6 +9,7 @@
 namespace sdkgenny {
 
 Namespace::Namespace(std::string_view name) : Typename{name} {
+    m_kind |= detail::KIND_NAMESPACE;
 }
 
 Type* Namespace::type(std::string_view name) {
@@ -1,12 +1,134 @@
+#include <cstddef>
 #include <sstream>
+#include <tuple>
 
 #include <sdkgenny/namespace.hpp>
+#include <sdkgenny/sdk.hpp>
 #include <sdkgenny/struct.hpp>
+#include <sdkgenny/variable.hpp>
 
 #include <sdkgenny/object.hpp>
 
 namespace sdkgenny {
-Object::Object(std::string_view name) : m_name{name} {
+// Every object is prefixed with the arena it came from (nullptr for the global heap) so operator delete knows whether
+// there is anything to free.
+constexpr auto ALLOCATION_HEADER_SIZE = alignof(std::max_align_t);
+
+// Children that a struct's size depends on: its fields, and its virtual functions since they add a vtable.
+constexpr auto SIZE_AFFECTING_KINDS = detail::KIND_VARIABLE | detail::KIND_VIRTUAL_FUNCTION;
+
+Object::Object(std::string_view name) {
+    if (auto pool = detail::StringPool::current()) {
+        m_name = &pool->intern(name);
+        m_name_pool = pool;
+    } else {
+        m_own_name = std::make_unique<std::string>(name);
+        m_name = m_own_name.get();
+    }
+}
+
+Object::~Object() {
+    // The derived types go first since they point at our children, and by then there's no index left for each child to
+    // drop its entries from.
+    m_derived_types.reset();
+    m_children.clear();
+}
+
+void* Object::operator new(size_t size) {
+    return operator new(size, nullptr);
+}
+
+void* Object::operator new(size_t size, detail::Arena* arena) {
+    void* p{};
+
+    if (arena != nullptr) {
+        p = arena->allocate(ALLOCATION_HEADER_SIZE + size, alignof(std::max_align_t));
+        arena->retain();
+    } else {
+        p = ::operator new(ALLOCATION_HEADER_SIZE + size);
+    }
+
+    *static_cast<detail::Arena**>(p) = arena;
+
+    return static_cast<std::byte*>(p) + ALLOCATION_HEADER_SIZE;
+}
+
+void Object::operator delete(void* p) {
+    if (p == nullptr) {
+        return;
+    }
+
+    auto block = static_cast<std::byte*>(p) - ALLOCATION_HEADER_SIZE;
+
+    // Arena allocations are released in bulk once the Sdk and everything else allocated from the arena is gone.
+    if (auto arena = *reinterpret_cast<detail::Arena**>(block); arena != nullptr) {
+        arena->release();
+    } else {
+        ::operator delete(block);
+    }
+}
+
+void Object::operator delete(void* p, detail::Arena*) {
+    operator delete(p);
+}
+
+void detail::UsableName::policy_changed() {
+    invalidate();
+
+    // Paths and qualified names are built from usable names.
+    if (m_object != nullptr) {
+        m_object->reset_name_caches();
+    }
+}
+
+detail::Arena* Object::arena() const {
+    auto sdk = is_a<Sdk>() ? (const Sdk*)this : m_sdk;
+
+    return sdk != nullptr ? sdk->arena() : nullptr;
+}
+
+detail::StringPool* Object::string_pool() const {
+    auto sdk = is_a<Sdk>() ? (const Sdk*)this : m_sdk;
+
+    return sdk != nullptr ? sdk->string_pool() : nullptr;
+}
+
+Object* Object::name(std::string name) {
+    auto indexed = is_child() && m_owner->m_child_index != nullptr;
+
+    if (indexed) {
+        m_owner->unindex_child(this);
+    }
+
+    if (m_own_name != nullptr) {
+        *m_own_name = std::move(name);
+    } else if (auto pool = string_pool()) {
+        m_name = &pool->intern(name);
+        m_name_pool = pool;
+    } else {
+        // Created by make() for an Sdk but never added to it.
+        m_own_name = std::make_unique<std::string>(std::move(name));
+        m_name = m_own_name.get();
+        m_name_pool = nullptr;
+    }
+
+    if (indexed) {
+        m_owner->index_child(this);
+    }
+
+    if (auto struct_ = m_owner != nullptr ? m_owner->as<Struct>() : nullptr) {
+        struct_->names_released();
+    }
+
+    if (auto instance = as<Struct>()) {
+        instance->forget_instance();
+    }
+
+    usable_name.invalidate();
+    usable_name_decl.invalidate();
+    reset_name_caches();
+
+    return this;
 }
 
 void Object::generate_metadata(std::ostream& os) const {
@@ -40,22 +162,371 @@ void Object::generate_comment(std::ostream& os) const {
 }
 
 std::unique_ptr<Object> Object::remove(Object* obj) {
-    obj->m_owner = nullptr;
+    // The Sdk owns its global namespace without it being one of its children.
+    if (obj == nullptr || obj->m_owner != this || obj->m_slot >= m_children.size() ||
+        m_children[obj->m_slot].get() != obj) {
+        return nullptr;
+    }
+
+    if (m_child_index != nullptr) {
+        unindex_child(obj);
+    }
+
+    if ((obj->m_kind & detail::BUCKETED_KINDS) != 0) {
+        unbucket_child(obj);
+    }
+
+    if (auto struct_ = as<Struct>(); struct_ != nullptr && obj->is_a<Variable>() && obj->as<Variable>()->type()) {
+        struct_->size_dependency_released(obj->as<Variable>()->type());
+    }
+
+    if (m_derived_types != nullptr) {
+        m_derived_types->index.erase(obj);
+    }
+
+    auto p = std::move(m_children[obj->m_slot]);
+    ++m_holes;
+
+    if (m_holes * 2 > m_children.size()) {
+        compact_children();
+    }
+
+    if (auto struct_ = as<Struct>()) {
+        struct_->names_released();
+    }
+
+    if (auto instance = p->as<Struct>()) {
+        instance->forget_instance();
+    }
+
+    p->m_owner = nullptr;
+    p->relink();
+    structure_changed();
+    return p;
+}
+
+void Object::children_removed(std::vector<std::unique_ptr<Object>>& removed) {
+    auto struct_ = as<Struct>();
+
+    for (auto&& obj : removed) {
+        if (m_child_index != nullptr) {
+            unindex_child(obj.get());
+        }
+
+        // Before compacting, while the layout's ordering by slot still holds.
+        if (struct_ != nullptr && obj->is_a<Variable>()) {
+            struct_->layout_erase(obj->as<Variable>());
+        }
+
+        if (auto instance = obj->as<Struct>()) {
+            instance->forget_instance();
+        }
+
+        if (m_derived_types != nullptr) {
+            m_derived_types->index.erase(obj.get());
+        }
+
+        obj->m_owner = nullptr;
+    }
+
+    compact_children();
+
+    if (m_child_buckets != nullptr) {
+        for (auto i = 0u; i < detail::BUCKET_COUNT; ++i) {
+            compact_bucket((detail::Bucket)i);
+        }
+    }
+
+    if (auto type = as<Type>(); type != nullptr && std::ranges::any_of(removed, [](auto&& obj) {
+            return (obj->m_kind & SIZE_AFFECTING_KINDS) != 0;
+        })) {
+        type->size_changed();
+    }
+
+    if (struct_ != nullptr) {
+        for (auto&& obj : removed) {
+            if (auto var = obj->as<Variable>(); var != nullptr && var->type() != nullptr) {
+                struct_->size_dependency_released(var->type());
+            }
+        }
+
+        struct_->names_released();
+    }
+
+    if (std::ranges::any_of(
+            removed, [](auto&& obj) { return (obj->m_kind & detail::KIND_VIRTUAL_FUNCTION) != 0; })) {
+        vtables_changed();
+    }
+
+    for (auto&& obj : removed) {
+        obj->relink();
+    }
+
+    structure_changed();
+}
+
+void Object::compact_children() {
+    std::erase(m_children, nullptr);
+
+    for (uint32_t i = 0; i < m_children.size(); ++i) {
+        m_children[i]->m_slot = i;
+    }
+
+    m_holes = 0;
+}
+
+void Object::build_child_index() {
+    m_child_index = std::make_unique<ChildIndex>(resource());
+    m_child_index->reserve(m_children.size());
+
+    for (auto child : live_children()) {
+        child_index_entry(*child->m_name).emplace_back(child);
+    }
+}
+
+std::pmr::vector<Object*>& Object::child_index_entry(std::string_view name) {
+    if (auto search = m_child_index->find(name); search != m_child_index->end()) {
+        return search->second;
+    }
+
+    // Constructed in place so the key is allocated like the rest of the index.
+    return m_child_index->emplace(std::piecewise_construct, std::forward_as_tuple(name), std::tuple<>{}).first->second;
+}
+
+void Object::index_child(Object* child) {
+    auto& bucket = child_index_entry(*child->m_name);
+
+    if (bucket.empty()) {
+        bucket.emplace_back(child);
+        return;
+    }
+
+    // Another child already has this name so rebuild the bucket to keep it in declaration order. This only happens
+    // when a child is renamed to collide with a sibling which is rare.
+    bucket.clear();
+
+    for (auto c : live_children()) {
+        if (*c->m_name == *child->m_name) {
+            bucket.emplace_back(c);
+        }
+    }
+}
+
+void Object::unindex_child(Object* child) {
+    auto search = m_child_index->find(std::string_view{*child->m_name});
+
+    if (search == m_child_index->end()) {
+        return;
+    }
+
+    auto& bucket = search->second;
+
+    std::erase(bucket, child);
+
+    if (bucket.empty()) {
+        m_child_index->erase(search);
+    }
+}
+
+// Which of an object's bucket slots holds its position in a bucket.
+static auto bucket_slot_index(uint32_t kind, uint32_t bucket) {
+    auto index = 0u;
+
+    for (auto i = 0u; i < bucket; ++i) {
+        if ((kind & detail::bucket_kinds[i]) != 0) {
+            ++index;
+        }
+    }
+
+    return index;
+}
+
+void Object::bucket_child(Object* child) {
+    if (m_child_buckets == nullptr) {
+        m_child_buckets = std::make_unique<ChildBuckets>(resource());
+    }
+
+    auto n = 0;
+
+    for (auto i = 0u; i < detail::BUCKET_COUNT; ++i) {
+        if ((child->m_kind & detail::bucket_kinds[i]) != 0) {
+            auto& bucket = m_child_buckets->objects[i];
+
+            child->m_bucket_slots[n++] = (uint32_t)bucket.size();
+            bucket.emplace_back(child);
+        }
+    }
+
+    if (auto struct_ = as<Struct>(); struct_ != nullptr && child->is_a<Variable>()) {
+        struct_->layout_insert(child->as<Variable>());
+    }
+
+    if ((child->m_kind & detail::KIND_VIRTUAL_FUNCTION) != 0) {
+        vtables_changed();
+    }
+
+    if (auto type = as<Type>(); type != nullptr && (child->m_kind & SIZE_AFFECTING_KINDS) != 0) {
+        if (auto var = child->as<Variable>(); var != nullptr && var->type() != nullptr) {
+            var->type()->add_size_dependent(type);
+        }
+
+        type->size_changed();
+    }
+}
+
+void Object::unbucket_child(Object* child) {
+    if (m_child_buckets == nullptr) {
+        return;
+    }
+
+    auto n = 0;
+
+    for (auto i = 0u; i < detail::BUCKET_COUNT; ++i) {
+        if ((child->m_kind & detail::bucket_kinds[i]) != 0) {
+            auto& bucket = m_child_buckets->objects[i];
+            auto& holes = m_child_buckets->holes[i];
+
+            bucket[child->m_bucket_slots[n++]] = nullptr;
+
+            if (++holes * 2 > bucket.size()) {
+                compact_bucket((detail::Bucket)i);
+            }
+        }
+    }
+
+    if (auto struct_ = as<Struct>(); struct_ != nullptr && child->is_a<Variable>()) {
+        struct_->layout_erase(child->as<Variable>());
+    }
+
+    if ((child->m_kind & detail::KIND_VIRTUAL_FUNCTION) != 0) {
+        vtables_changed();
+    }
+
+    if (auto type = as<Type>(); type != nullptr && (child->m_kind & SIZE_AFFECTING_KINDS) != 0) {
+        type->size_changed();
+    }
+}
+
+void Object::compact_bucket(detail::Bucket bucket) {
+    auto& objects = m_child_buckets->objects[bucket];
 
-    if (auto search = std::find_if(m_children.begin(), m_children.end(), [obj](auto&& c) { return c.get() == obj; });
-        search != m_children.end()) {
-        auto p = std::move(*search);
-        m_children.erase(search);
-        return p;
+    std::erase_if(objects, [this](Object* child) { return child == nullptr || child->m_owner != this; });
+
+    for (uint32_t i = 0; i < objects.size(); ++i) {
+        objects[i]->m_bucket_slots[bucket_slot_index(objects[i]->m_kind, bucket)] = i;
+    }
+
+    m_child_buckets->holes[bucket] = 0;
+}
+
+void Object::relink() {
+    auto old_sdk = m_sdk;
+
+    if (m_owner != nullptr) {
+        m_sdk = m_owner->is_a<Sdk>() ? (Sdk*)m_owner : m_owner->m_sdk;
+        m_owner_ns = m_owner->is_a<Namespace>() ? (Namespace*)m_owner : m_owner->m_owner_ns;
+        m_owner_struct = m_owner->is_a<Struct>() ? (Struct*)m_owner : m_owner->m_owner_struct;
+    } else {
+        m_sdk = nullptr;
+        m_owner_ns = nullptr;
+        m_owner_struct = nullptr;
+    }
+
+    m_name_cache.reset();
+
+    // A type moving between Sdks may still be size linked to types in the one it left.
+    if (old_sdk != m_sdk && is_a<Type>()) {
+        for (auto sdk : {old_sdk, m_sdk}) {
+            if (sdk != nullptr) {
+                sdk->m_has_foreign_size_links = true;
+            }
+        }
+    }
+
+    // The name may still be our own, or in the pool of another Sdk we were made by or removed from.
+    if (m_sdk != nullptr && m_name_pool != m_sdk->string_pool()) {
+        m_name_pool = m_sdk->string_pool();
+        m_name = &m_name_pool->intern(*m_name);
+        m_own_name.reset();
+    } else if (m_sdk == nullptr && m_name_pool != nullptr) {
+        // Leaving the Sdk, so we no longer depend on its pool.
+        m_own_name = std::make_unique<std::string>(*m_name);
+        m_name = m_own_name.get();
+        m_name_pool = nullptr;
+    }
+
+    for (auto child : live_children()) {
+        child->relink();
+    }
+
+    if (m_derived_types != nullptr) {
+        for (auto&& type : m_derived_types->owned) {
+            type->relink();
+        }
+    }
+}
+
+void Object::structure_changed() {
+    if (auto sdk = is_a<Sdk>() ? (Sdk*)this : m_sdk) {
+        ++sdk->m_structure_revision;
+    }
+}
+
+void Object::vtables_changed() {
+    if (auto sdk = is_a<Sdk>() ? (Sdk*)this : m_sdk) {
+        ++sdk->m_vtable_revision;
+    }
+}
+
+void Object::dependencies_changed() {
+    if (auto sdk = is_a<Sdk>() ? (Sdk*)this : m_sdk) {
+        ++sdk->m_dependency_revision;
+    }
+}
+
+bool Object::is_owned_by(const Object* obj) const {
+    if (obj == nullptr) {
+        return false;
+    }
+
+    if (m_sdk != nullptr && (obj->m_sdk == m_sdk || obj == m_sdk)) {
+        return m_sdk->is_owned_by(this, obj);
+    }
+
+    for (auto owner = m_owner; owner != nullptr; owner = owner->m_owner) {
+        if (owner == obj) {
+            return true;
+        }
     }
-    /* m_children.erase(
-        std::remove_if(m_children.begin(), m_children.end(), [obj](auto&& c) { return c.get() == obj; }));*/
-    return nullptr;
+
+    return false;
 }
 
-std::filesystem::path Object::path() {
+void Object::reset_name_caches() {
+    m_name_cache.reset();
+
+    for (auto child : live_children()) {
+        child->reset_name_caches();
+    }
+}
+
+Object::NameCache& Object::name_cache() const {
+    if (m_name_cache == nullptr) {
+        m_name_cache = std::make_unique<NameCache>();
+    }
+
+    return *m_name_cache;
+}
+
+std::filesystem::path Object::path() const {
+    auto& cache = name_cache();
+
+    if (cache.path) {
+        return *cache.path;
+    }
+
     if (m_owner == nullptr) {
-        return usable_name();
+        return *(cache.path = usable_name());
     }
 
     std::filesystem::path p{};
@@ -76,6 +547,21 @@ std::filesystem::path Object::path() {
         p /= usable_name();
     }
 
-    return p;
+    return *(cache.path = std::move(p));
+}
+
+const std::string& Object::qualified_name() const {
+    auto& cache = name_cache();
+
+    if (cache.qualified_name) {
+        return *cache.qualified_name;
+    }
+
+    // The global namespace has no name and the Sdk isn't a scope of its own.
+    if (m_owner == nullptr || m_owner->is_a<Sdk>() || m_owner->usable_name().empty()) {
+        return *(cache.qualified_name = usable_name());
+    }
+
+    return *(cache.qualified_name = m_owner->qualified_name() + "::" + usable_name());
 }
 } // namespace sdkgenny
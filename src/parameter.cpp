@@ -4,6 +4,7 @@
 
 namespace sdkgenny {
 Parameter::Parameter(std::string_view name) : Object{name} {
+    m_kind |= detail::KIND_PARAMETER;
 }
 
 void Parameter::generate(std::ostream& os) const {
@@ -2,6 +2,7 @@
 
 namespace sdkgenny {
 Pointer::Pointer(std::string_view name) : Reference{name} {
+    m_kind |= detail::KIND_POINTER;
 }
 
 void Pointer::generate_typename_for(std::ostream& os, const Object* obj) const {
@@ -2,6 +2,7 @@
 
 namespace sdkgenny {
 Reference::Reference(std::string_view name) : Type{name} {
+    m_kind |= detail::KIND_REFERENCE;
 }
 
 void Reference::generate_typename_for(std::ostream& os, const Object* obj) const {
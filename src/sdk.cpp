@@ -1,23 +1,389 @@
+#include <algorithm>
+
+#include <sdkgenny/detail/thread_pool.hpp>
+
 #include <sdkgenny/sdk.hpp>
 
 namespace sdkgenny {
 Sdk::Sdk() : Object{"Sdk"} {
+    m_kind |= detail::KIND_SDK;
+
+    // Our own containers come from the arena as well, see ~Sdk().
+    m_home_arena = m_arena.get();
+    m_global_ns->m_home_arena = m_arena.get();
     m_global_ns->m_owner = this;
+    m_global_ns->relink();
+}
+
+Sdk::~Sdk() {
+    m_is_being_destroyed = true;
+
+    // Our types won't unlink themselves as they go, see ~Type().
+    if (m_has_foreign_size_links) {
+        unlink_foreign_size_links(m_global_ns.get());
+
+        for (auto child : live_children()) {
+            unlink_foreign_size_links(child);
+        }
+    }
+
+    // Children of the Sdk itself live in the arena too, and so do the types made from them and the index and buckets
+    // our Object base keeps for them, so they all have to go before it does rather than after our own members.
+    m_derived_types.reset();
+    m_children.clear();
+    m_child_index.reset();
+    m_child_buckets.reset();
+}
+
+bool Sdk::is_owned_by(const Object* obj, const Object* owner) const {
+    if (m_numbered_revision == m_structure_revision) {
+        return owner->m_pre < obj->m_pre && obj->m_post < owner->m_post;
+    }
+
+    auto found = false;
+
+    for (auto o = obj->m_owner; o != nullptr; o = o->m_owner) {
+        ++m_stale_walk_cost;
+
+        if (o == owner) {
+            found = true;
+            break;
+        }
+    }
+
+    if (m_stale_walk_cost >= m_numbered_count) {
+        renumber();
+    }
+
+    return found;
+}
+
+void Sdk::renumber() const {
+    uint32_t counter{};
+
+    m_pre = counter++;
+    number(m_global_ns.get(), counter);
+
+    for (auto child : live_children()) {
+        number(child, counter);
+    }
+
+    m_post = counter++;
+    m_numbered_revision = m_structure_revision;
+    m_numbered_count = counter / 2;
+    m_stale_walk_cost = 0;
+}
+
+void Sdk::number(const Object* obj, uint32_t& counter) const {
+    obj->m_pre = counter++;
+
+    for (auto child : obj->live_children()) {
+        number(child, counter);
+    }
+
+    if (obj->m_derived_types != nullptr) {
+        for (auto&& type : obj->m_derived_types->owned) {
+            number(type.get(), counter);
+        }
+    }
+
+    obj->m_post = counter++;
+}
+
+void Sdk::unlink_foreign_size_links(Object* obj) {
+    if (auto type = obj->as<Type>(); type != nullptr && type->m_size_links != nullptr) {
+        auto is_foreign = [this](const Type* other) { return other->m_sdk != this; };
+
+        for (auto&& dependency : type->m_size_links->dependencies) {
+            if (is_foreign(dependency)) {
+                std::erase(dependency->m_size_links->dependents, type);
+            }
+        }
+
+        for (auto&& dependent : type->m_size_links->dependents) {
+            if (is_foreign(dependent)) {
+                std::erase(dependent->m_size_links->dependencies, type);
+            }
+        }
+
+        std::erase_if(type->m_size_links->dependencies, is_foreign);
+        std::erase_if(type->m_size_links->dependents, is_foreign);
+    }
+
+    for (auto child : obj->live_children()) {
+        unlink_foreign_size_links(child);
+    }
+
+    if (obj->m_derived_types != nullptr) {
+        for (auto&& type : obj->m_derived_types->owned) {
+            unlink_foreign_size_links(type.get());
+        }
+    }
+}
+
+const Struct::DependencyGraph& Sdk::dependency_graph() const {
+    if (!dependency_graph_is_current()) {
+        m_dependency_graph.clear();
+        build_dependency_graph(m_global_ns.get());
+        m_graph_structure_revision = m_structure_revision;
+        m_graph_dependency_revision = m_dependency_revision;
+    }
+
+    return m_dependency_graph;
+}
+
+void Sdk::build_dependency_graph(Object* obj) const {
+    for (auto&& ns : obj->child_view<Namespace>()) {
+        build_dependency_graph(ns);
+    }
+
+    // Nested structs go first so their owners can reuse their dependencies.
+    for (auto&& s : obj->child_view<Struct>()) {
+        build_dependency_graph(s);
+        m_dependency_graph.emplace(s, s->collect_dependencies(m_dependency_graph));
+    }
+}
+
+static void collect_layout_issues(Object* obj, std::vector<Struct::LayoutIssue>& issues) {
+    for (auto&& ns : obj->child_view<Namespace>()) {
+        collect_layout_issues(ns, issues);
+    }
+
+    for (auto&& s : obj->child_view<Struct>()) {
+        s->validate_layout(issues);
+        collect_layout_issues(s, issues);
+    }
+}
+
+std::vector<Struct::LayoutIssue> Sdk::validate_layouts() const {
+    std::vector<Struct::LayoutIssue> issues{};
+
+    collect_layout_issues(m_global_ns.get(), issues);
+
+    return issues;
+}
+
+void Sdk::collect_size_dependents(Type* type, std::unordered_set<Type*>& visited, std::vector<Type*>& order) {
+    if (!visited.emplace(type).second) {
+        return;
+    }
+
+    if (auto links = type->m_size_links; links != nullptr) {
+        for (auto&& dependent : links->dependents) {
+            collect_size_dependents(dependent, visited, order);
+        }
+    }
+
+    order.emplace_back(type);
+}
+
+std::vector<Struct*> Sdk::reflow(const std::vector<Struct*>& edited) {
+    std::unordered_set<Type*> visited{};
+    std::vector<Type*> order{};
+
+    for (auto&& s : edited) {
+        collect_size_dependents(s, visited, order);
+    }
+
+    std::unordered_set<Type*> seeds{edited.begin(), edited.end()};
+    std::unordered_set<Type*> changed{};
+    std::vector<Struct*> changed_structs{};
+
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        auto type = *it;
+        auto affected = seeds.contains(type);
+
+        if (!affected && type->m_size_links != nullptr) {
+            affected = std::ranges::any_of(
+                type->m_size_links->dependencies, [&](Type* dependency) { return changed.contains(dependency); });
+        }
+
+        if (!affected) {
+            continue;
+        }
+
+        // Arrays and enums just pass the change on.
+        if (auto s = type->as<Struct>()) {
+            if (!s->reflow()) {
+                continue;
+            }
+
+            changed_structs.emplace_back(s);
+        }
+
+        changed.emplace(type);
+    }
+
+    return changed_structs;
 }
 
-void Sdk::generate(const std::filesystem::path& sdk_path) const {
+size_t Sdk::layout_level(
+    Type* type, std::unordered_map<Type*, size_t>& level_of, std::vector<std::vector<Type*>>& levels) {
+    // Marked before recursing so a cycle (which no valid layout has) ends here instead of recursing forever.
+    if (auto [search, inserted] = level_of.try_emplace(type, IN_PROGRESS); !inserted) {
+        return search->second != IN_PROGRESS ? search->second : 0;
+    }
+
+    size_t level = 0;
+
+    if (auto links = type->m_size_links; links != nullptr) {
+        for (auto&& dependency : links->dependencies) {
+            level = std::max(level, layout_level(dependency, level_of, levels) + 1);
+        }
+    }
+
+    if (level >= levels.size()) {
+        levels.resize(level + 1);
+    }
+
+    levels[level].emplace_back(type);
+    level_of[type] = level;
+
+    return level;
+}
+
+void Sdk::collect_layout_levels(
+    Object* obj, std::unordered_map<Type*, size_t>& level_of, std::vector<std::vector<Type*>>& levels) const {
+    for (auto&& ns : obj->child_view<Namespace>()) {
+        collect_layout_levels(ns, level_of, levels);
+    }
+
+    for (auto&& s : obj->child_view<Struct>()) {
+        layout_level(s, level_of, levels);
+        collect_layout_levels(s, level_of, levels);
+    }
+}
+
+void Sdk::resolve_layouts(size_t jobs) const {
+    std::unordered_map<Type*, size_t> level_of{};
+    std::vector<std::vector<Type*>> levels{};
+
+    collect_layout_levels(m_global_ns.get(), level_of, levels);
+
+    detail::ThreadPool pool{jobs};
+
+    // Everything a type reads while resolving is in an earlier level and already cached, so the types of one level
+    // only ever write their own caches.
+    for (auto&& level : levels) {
+        pool.parallel_for(level.size(), [&](size_t i) {
+            auto type = level[i];
+
+            type->size();
+
+            if (auto s = type->as<Struct>()) {
+                s->vtable();
+            }
+        });
+    }
+}
+
+void Sdk::generate(const std::filesystem::path& sdk_path, size_t jobs) const {
     // erase the file_list.txt
     std::filesystem::remove(sdk_path / "file_list.txt");
 
-    generate_namespace(sdk_path, m_global_ns.get());
+    std::vector<Object*> objects{};
+
+    collect_generated(m_global_ns.get(), objects);
+
+    detail::ThreadPool pool{jobs};
+
+    // On a single thread the caches just fill up as generation goes, computing nothing it wouldn't need. Except for
+    // the dependencies, which every struct generated needs and are cheaper built for all of them in one pass.
+    if (pool.size() > 1) {
+        prepare_generation(pool.size());
+    } else {
+        dependency_graph();
+    }
+
+    // Headers and sources go in the same directory, so creating those of the headers covers both.
+    std::set<std::filesystem::path> directories{};
+
+    for (auto&& obj : objects) {
+        if (!obj->skip_generation()) {
+            directories.emplace((sdk_path / obj->path()).parent_path());
+        }
+    }
+
+    for (auto&& directory : directories) {
+        std::filesystem::create_directories(directory);
+    }
+
+    // Each file's entries are kept apart and listed afterwards so the list doesn't depend on which file finished
+    // first.
+    std::vector<std::string> file_lists(objects.size());
+
+    pool.parallel_for(objects.size(), [&](size_t i) {
+        std::ostringstream file_list{};
+
+        if (auto e = objects[i]->as<Enum>()) {
+            generate_header(sdk_path, e, file_list);
+            generate_source(sdk_path, e, file_list);
+        } else if (auto s = objects[i]->as<Struct>()) {
+            generate_header(sdk_path, s, file_list);
+            generate_source(sdk_path, s, file_list);
+        }
+
+        file_lists[i] = std::move(file_list).str();
+    });
+
+    if (std::ranges::all_of(file_lists, [](auto&& list) { return list.empty(); })) {
+        return;
+    }
+
+    std::ofstream file_list{sdk_path / "file_list.txt", std::ios::app};
+
+    for (auto&& list : file_lists) {
+        file_list << list;
+    }
+}
+
+void Sdk::collect_generated(Namespace* ns, std::vector<Object*>& objects) const {
+    for (auto&& e : ns->child_view<Enum>()) {
+        objects.emplace_back(e);
+    }
+
+    for (auto&& s : ns->child_view<Struct>()) {
+        objects.emplace_back(s);
+    }
+
+    for (auto&& child : ns->child_view<Namespace>()) {
+        collect_generated(child, objects);
+    }
 }
 
-void Sdk::generate_namespace(const std::filesystem::path& sdk_path, Namespace* ns) const {
-    generate<Enum>(sdk_path, ns);
-    generate<Struct>(sdk_path, ns);
+void Sdk::prepare_generation(size_t jobs) const {
+    resolve_layouts(jobs);
+    dependency_graph();
+
+    if (m_numbered_revision != m_structure_revision) {
+        renumber();
+    }
+
+    prepare_generation(m_global_ns.get());
+}
+
+void Sdk::prepare_generation(const Object* obj) const {
+    obj->usable_name();
+    obj->usable_name_decl();
+    obj->path();
+    obj->qualified_name();
+
+    if (auto type = obj->as<Type>()) {
+        type->size();
+    }
+
+    if (auto s = obj->as<Struct>()) {
+        s->vtable();
+    }
+
+    for (auto child : obj->live_children()) {
+        prepare_generation(child);
+    }
 
-    for (auto&& child : ns->get_all<Namespace>()) {
-        generate_namespace(sdk_path, child);
+    if (obj->m_derived_types != nullptr) {
+        for (auto&& type : obj->m_derived_types->owned) {
+            prepare_generation(type.get());
+        }
     }
 }
 
@@ -2,6 +2,7 @@
 
 namespace sdkgenny {
 StaticFunction::StaticFunction(std::string_view name) : Function{name} {
+    m_kind |= detail::KIND_STATIC_FUNCTION;
 }
 
 void StaticFunction::generate(std::ostream& os) const {
@@ -1,6 +1,8 @@
 #include <cctype>
+#include <charconv>
 #include <climits>
 #include <cstring>
+#include <limits>
 #include <sstream>
 #include <unordered_map>
 
@@ -14,6 +16,7 @@
 #include <sdkgenny/generic_type.hpp>
 #include <sdkgenny/parameter.hpp>
 #include <sdkgenny/reference.hpp>
+#include <sdkgenny/sdk.hpp>
 #include <sdkgenny/static_function.hpp>
 #include <sdkgenny/variable.hpp>
 #include <sdkgenny/virtual_function.hpp>
@@ -24,6 +27,7 @@
 
 namespace sdkgenny {
 Struct::Struct(std::string_view name) : Type{name} {
+    m_kind |= detail::KIND_STRUCT;
 }
 
 Variable* Struct::variable(std::string_view name) {
@@ -37,17 +41,513 @@ Constant* Struct::constant(std::string_view name) {
 std::map<uintptr_t, Variable*> Struct::bitfield(uintptr_t offset, Variable* ignore) const {
     std::map<uintptr_t, Variable*> vars{};
 
-    for (auto&& child : m_children) {
-        if (auto var = dynamic_cast<Variable*>(child.get()); var != nullptr && var != ignore) {
-            if (var->offset() == offset) {
-                vars[var->bit_offset()] = var;
-            }
+    for (auto&& var : layout_group(offset)) {
+        if (var != ignore) {
+            vars[var->bit_offset()] = var;
         }
     }
 
     return vars;
 }
 
+bool Struct::LayoutOrder::operator()(const Variable* a, const Variable* b) const {
+    if (a->offset() != b->offset()) {
+        return a->offset() < b->offset();
+    }
+
+    if (a->bit_offset() != b->bit_offset()) {
+        return a->bit_offset() < b->bit_offset();
+    }
+
+    return a->m_slot < b->m_slot;
+}
+
+bool Struct::LayoutOrder::operator()(const Variable* a, uintptr_t offset) const {
+    return a->offset() < offset;
+}
+
+bool Struct::LayoutOrder::operator()(uintptr_t offset, const Variable* b) const {
+    return offset < b->offset();
+}
+
+void Struct::layout_insert(Variable* var) {
+    if (m_layout == nullptr) {
+        m_layout = std::make_unique<Layout>(resource());
+    }
+
+    m_layout->emplace(var);
+}
+
+void Struct::layout_erase(Variable* var) {
+    if (m_layout != nullptr) {
+        m_layout->erase(var);
+    }
+}
+
+bool Struct::layout_contains(const Variable* var) const {
+    return var->m_owner == this;
+}
+
+std::ranges::subrange<Struct::Layout::const_iterator> Struct::layout_group(uintptr_t offset) const {
+    if (m_layout == nullptr) {
+        return {};
+    }
+
+    auto [first, last] = m_layout->equal_range(offset);
+
+    return {first, last};
+}
+
+Variable* Struct::latest_declared(Layout::const_iterator first, Layout::const_iterator last, const Variable* ignore) {
+    Variable* latest{};
+
+    for (auto it = first; it != last; ++it) {
+        if (*it != ignore && (latest == nullptr || (*it)->m_slot > latest->m_slot)) {
+            latest = *it;
+        }
+    }
+
+    return latest;
+}
+
+Variable* Struct::layout_tail(const Variable* ignore) const {
+    if (m_layout == nullptr) {
+        return nullptr;
+    }
+
+    // Only steps back past the last group when it holds nothing but the ignored variable.
+    for (auto last = m_layout->cend(); last != m_layout->cbegin();) {
+        auto first = m_layout->lower_bound((*std::prev(last))->offset());
+
+        if (auto var = latest_declared(first, last, ignore)) {
+            return var;
+        }
+
+        last = first;
+    }
+
+    return nullptr;
+}
+
+Variable* Struct::bitfield_tail(uintptr_t offset, const Variable* ignore) const {
+    auto group = layout_group(offset);
+
+    for (auto it = group.end(); it != group.begin();) {
+        if (*--it != ignore) {
+            return *it;
+        }
+    }
+
+    return nullptr;
+}
+
+size_t Struct::free_suffix(std::string_view base, size_t from) {
+    auto search = m_used_suffixes.find(base);
+
+    if (search == m_used_suffixes.end()) {
+        search = m_used_suffixes.emplace(base, 0).first;
+    }
+
+    auto& used = search->second;
+    auto suffix = std::max(from, used);
+
+    // Kept between calls so probing names doesn't allocate once it's grown to fit.
+    thread_local std::string name{};
+    char digits[std::numeric_limits<size_t>::digits10 + 1]{};
+
+    name.assign(base);
+
+    for (;; ++suffix) {
+        name.resize(base.size());
+        name.append(digits, std::to_chars(std::begin(digits), std::end(digits), suffix).ptr);
+
+        if (find<Object>(name) == nullptr) {
+            break;
+        }
+    }
+
+    if (from <= used) {
+        used = suffix;
+    }
+
+    return suffix;
+}
+
+std::vector<Struct::FieldLocation> Struct::field_at(uintptr_t offset) const {
+    std::vector<FieldLocation> chain{};
+
+    resolve_field(offset, 0, chain);
+
+    return chain;
+}
+
+void Struct::resolve_field(uintptr_t offset, uintptr_t base, std::vector<FieldLocation>& chain) const {
+    uintptr_t parent_start = 0;
+
+    for (auto&& parent : m_parents) {
+        auto parent_size = parent->size();
+
+        if (offset < parent_start + parent_size) {
+            parent->resolve_field(offset - parent_start, base + parent_start, chain);
+            return;
+        }
+
+        parent_start += parent_size;
+    }
+
+    if (m_layout == nullptr) {
+        return;
+    }
+
+    auto& index = field_index();
+    Variable* var{};
+
+    // Back from the last field starting at or before the offset, for as long as something may still reach it.
+    for (auto i = std::ranges::upper_bound(index.offsets, offset) - index.offsets.begin();
+         i-- > 0 && index.reach[i] > offset;) {
+        auto candidate = index.vars[i];
+
+        if (var != nullptr && candidate->offset() < var->offset()) {
+            break;
+        }
+
+        if (candidate->end() > offset && (var == nullptr || candidate->m_slot > var->m_slot)) {
+            var = candidate;
+        }
+    }
+
+    if (var == nullptr) {
+        return;
+    }
+
+    auto inner = offset - var->offset();
+    auto type = var->type();
+    auto& location = chain.emplace_back(FieldLocation{var, base + var->offset()});
+
+    if (var->is_bitfield()) {
+        location.bit_offset = var->bit_offset();
+        location.bit_size = var->bit_size();
+    }
+
+    for (auto arr = type->as<Array>(); arr != nullptr && arr->of() != nullptr; arr = type->as<Array>()) {
+        auto element_size = arr->of()->size();
+
+        location.indices.emplace_back(inner / element_size);
+        inner %= element_size;
+        type = arr->of();
+    }
+
+    if (auto s = type->as<Struct>()) {
+        s->resolve_field(inner, base + offset - inner, chain);
+    }
+}
+
+const Struct::FieldIndex& Struct::field_index() const {
+    if (m_field_index != nullptr) {
+        return *m_field_index;
+    }
+
+    // Caching the size first means whatever drops it from now on drops the index too.
+    size();
+
+    auto index = std::make_unique<FieldIndex>();
+    uintptr_t reach{};
+
+    for (auto&& var : *m_layout) {
+        if (var->size() == 0) {
+            continue;
+        }
+
+        reach = std::max<uintptr_t>(reach, var->end());
+        index->offsets.emplace_back(var->offset());
+        index->reach.emplace_back(reach);
+        index->vars.emplace_back(var);
+    }
+
+    m_field_index = std::move(index);
+
+    return *m_field_index;
+}
+
+std::string Struct::field_path(const std::vector<FieldLocation>& chain) {
+    std::string path{};
+
+    for (auto&& location : chain) {
+        if (path.empty()) {
+            path = location.var->qualified_name();
+        } else {
+            path += '.';
+            path += location.var->usable_name();
+        }
+
+        for (auto&& index : location.indices) {
+            path += '[' + std::to_string(index) + ']';
+        }
+    }
+
+    return path;
+}
+
+std::optional<Struct::FieldPlan> Struct::compile_path(std::string_view path) const {
+    FieldPlan plan{{0}};
+    auto struct_ = this;
+    Type* type{};
+    size_t pos = 0;
+
+    auto parse_name = [&]() -> std::string_view {
+        auto start = pos;
+
+        while (pos < path.size() && (std::isalnum((unsigned char)path[pos]) || path[pos] == '_')) {
+            ++pos;
+        }
+
+        return path.substr(start, pos - start);
+    };
+
+    // Moves on to the pointee when type is a pointer or reference, starting a new offset after reading it.
+    auto deref = [&] {
+        if (auto ref = type->as<Reference>(); ref != nullptr && ref->to() != nullptr) {
+            type = ref->to();
+            plan.offsets.emplace_back(0);
+            return true;
+        }
+
+        return false;
+    };
+
+    while (true) {
+        auto name = parse_name();
+        uintptr_t base{};
+
+        if (name.empty() || struct_ == nullptr) {
+            return std::nullopt;
+        }
+
+        plan.var = struct_->find_field(name, base);
+
+        if (plan.var == nullptr || plan.var->type() == nullptr) {
+            return std::nullopt;
+        }
+
+        plan.offsets.back() += base + plan.var->offset();
+        type = plan.var->type();
+
+        while (pos < path.size() && path[pos] == '[') {
+            auto close = path.find(']', pos);
+            size_t index{};
+
+            if (close == std::string_view::npos || close == pos + 1) {
+                return std::nullopt;
+            }
+
+            for (auto c : path.substr(pos + 1, close - pos - 1)) {
+                if (!std::isdigit((unsigned char)c)) {
+                    return std::nullopt;
+                }
+
+                index = index * 10 + (c - '0');
+            }
+
+            if (auto arr = type->as<Array>(); arr != nullptr && arr->of() != nullptr) {
+                if (index >= arr->count()) {
+                    return std::nullopt;
+                }
+
+                type = arr->of();
+            } else if (!deref()) {
+                return std::nullopt;
+            }
+
+            plan.offsets.back() += index * type->size();
+            pos = close + 1;
+        }
+
+        if (pos == path.size()) {
+            return plan;
+        }
+
+        if (path.substr(pos, 2) == "->") {
+            pos += 2;
+
+            if (!deref()) {
+                return std::nullopt;
+            }
+        } else if (path[pos] == '.') {
+            ++pos;
+
+            // "." through a pointer reads it just like "->".
+            deref();
+        } else {
+            return std::nullopt;
+        }
+
+        struct_ = type->as<Struct>();
+    }
+}
+
+Variable* Struct::find_field(std::string_view name, uintptr_t& base) const {
+    if (auto var = find<Variable>(name)) {
+        return var;
+    }
+
+    auto parent_base = base;
+
+    for (auto&& parent : m_parents) {
+        base = parent_base;
+
+        if (auto var = parent->find_field(name, base)) {
+            return var;
+        }
+
+        parent_base += parent->size();
+    }
+
+    return nullptr;
+}
+
+// Describes a field as "Owner::field (0x10-0x18)", or with its bits for bitfields.
+static void describe(std::ostream& os, const Variable* var) {
+    os << var->qualified_name() << " (0x" << std::hex << var->offset() << "-0x" << var->end();
+
+    if (var->is_bitfield()) {
+        os << ", bits " << std::dec << var->bit_offset() << "-" << var->bit_offset() + var->bit_size();
+    }
+
+    os << ")";
+}
+
+void Struct::size_dependency_released(Type* type) {
+    if (std::ranges::find(m_parents, type) != m_parents.end()) {
+        return;
+    }
+
+    for (auto&& var : child_view<Variable>()) {
+        if (var->type() == type) {
+            return;
+        }
+    }
+
+    type->remove_size_dependent(this);
+}
+
+bool Struct::reflow() {
+    // Without a size from before the edits, the one they left is the best there is to compare against.
+    auto old_size = m_size_before_edits != UNKNOWN_SIZE ? m_size_before_edits : size();
+    auto moved = false;
+
+    // Lay the fields out again one by one so each is placed against only those declared before it.
+    if (m_layout != nullptr) {
+        m_layout->clear();
+    }
+
+    for (auto&& var : child_view<Variable>()) {
+        auto offset = var->m_offset;
+        auto bit_offset = var->m_bit_offset;
+
+        if (var->m_offset_is_appended || var->m_has_delta) {
+            var->m_offset = var->appended_offset(this) + var->m_delta;
+        }
+
+        if (var->m_bit_offset_is_appended) {
+            var->m_bit_offset = var->appended_bit_offset(this);
+        }
+
+        layout_insert(var);
+        moved |= var->m_offset != offset || var->m_bit_offset != bit_offset;
+    }
+
+    if (moved) {
+        size_changed();
+    }
+
+    m_size_before_edits = UNKNOWN_SIZE;
+
+    return moved || size() != old_size;
+}
+
+void Struct::validate_layout(std::vector<LayoutIssue>& issues) const {
+    if (m_layout == nullptr || is_template() || is_template_instance()) {
+        return;
+    }
+
+    auto report = [&](LayoutIssue::Kind kind, Variable* var, Variable* other, std::string_view problem) {
+        std::ostringstream os{};
+
+        describe(os, var);
+        os << " " << problem;
+
+        if (other != nullptr) {
+            os << " ";
+            describe(os, other);
+        }
+
+        issues.emplace_back(LayoutIssue{kind, this, var, other, os.str()});
+    };
+
+    // Where generation starts laying out fields.
+    size_t base = 0;
+
+    for (auto&& parent : m_parents) {
+        base += parent->size();
+    }
+
+    if (m_parents.empty() && has_any<VirtualFunction>()) {
+        base = sizeof(uintptr_t);
+    }
+
+    // The field reaching furthest so far, and the bitfield reaching the furthest bit of the storage unit being walked.
+    Variable* reach{};
+    Variable* unit{};
+    Variable* bit_reach{};
+
+    for (auto var : *m_layout) {
+        auto size = var->size();
+
+        if (size == 0) {
+            continue;
+        }
+
+        if (var->offset() < base) {
+            report(LayoutIssue::PARENT_OVERLAP, var, nullptr,
+                m_parents.empty() ? "starts within the vtable pointer" : "starts within the parents");
+        }
+
+        if (m_size != 0 && var->end() > m_size) {
+            report(LayoutIssue::OUT_OF_BOUNDS, var, nullptr, "ends past the struct's size");
+        }
+
+        if (var->is_bitfield() && var->bit_offset() + var->bit_size() > size * CHAR_BIT) {
+            report(LayoutIssue::BITFIELD, var, nullptr, "doesn't fit in its type");
+        }
+
+        auto bit_end = [](const Variable* v) { return v->bit_offset() + v->bit_size(); };
+
+        if (var->is_bitfield() && unit != nullptr && var->offset() == unit->offset()) {
+            // Another bitfield in the same storage unit. The layout orders them by bit offset.
+            if (var->type() != unit->type()) {
+                report(LayoutIssue::BITFIELD, var, unit, "shares its storage unit with");
+            } else if (var->bit_offset() < bit_end(bit_reach)) {
+                report(LayoutIssue::BITFIELD, var, bit_reach, "overlaps the bits of");
+            }
+
+            if (bit_end(var) > bit_end(bit_reach)) {
+                bit_reach = var;
+            }
+        } else {
+            if (reach != nullptr && var->offset() < reach->end()) {
+                report(LayoutIssue::OVERLAP, var, reach, "overlaps");
+            }
+
+            unit = var->is_bitfield() ? var : nullptr;
+            bit_reach = unit;
+        }
+
+        if (reach == nullptr || var->end() > reach->end()) {
+            reach = var;
+        }
+    }
+}
+
 Struct* Struct::struct_(std::string_view name) {
     return find_or_add_unique<Struct>(name);
 }
@@ -74,7 +574,7 @@ TemplateParameter* Struct::template_parameter(std::string_view name) {
     if (auto existing = find<TemplateParameter>(name)) {
         return existing;
     }
-    auto param = add(std::make_unique<TemplateParameter>(name));
+    auto param = add(make<TemplateParameter>(name));
     m_template_params.emplace_back(param);
     return param;
 }
@@ -87,24 +587,53 @@ bool Struct::is_template() const {
     return !m_template_params.empty();
 }
 
-static Type* substitute_type(Type* type, const std::unordered_map<TemplateParameter*, Type*>& subst) {
-    if (auto tp = dynamic_cast<TemplateParameter*>(type)) {
-        auto it = subst.find(tp);
-        return it != subst.end() ? it->second : type;
+// subst maps each template parameter to its argument and doubles as a memo of every type substituted so far, so fields
+// sharing a type only have their Pointer/Reference/Array chain rebuilt once.
+static Type* substitute_type(Type* type, std::unordered_map<Type*, Type*>& subst) {
+    if (type == nullptr) {
+        return nullptr;
     }
-    if (auto ptr = dynamic_cast<Pointer*>(type)) {
-        auto new_to = substitute_type(ptr->to(), subst);
-        return new_to != ptr->to() ? new_to->ptr() : type;
+    if (auto it = subst.find(type); it != subst.end()) {
+        return it->second;
     }
-    if (auto ref = dynamic_cast<Reference*>(type)) {
+
+    auto result = type;
+
+    if (auto ptr = type->as<Pointer>()) {
+        auto new_to = substitute_type(ptr->to(), subst);
+        result = new_to != ptr->to() ? new_to->ptr() : type;
+    } else if (auto ref = type->as<Reference>()) {
         auto new_to = substitute_type(ref->to(), subst);
-        return new_to != ref->to() ? new_to->ref() : type;
-    }
-    if (auto arr = dynamic_cast<Array*>(type)) {
+        result = new_to != ref->to() ? new_to->ref() : type;
+    } else if (auto arr = type->as<Array>()) {
         auto new_of = substitute_type(arr->of(), subst);
-        return new_of != arr->of() ? new_of->array_(arr->count()) : type;
+        result = new_of != arr->of() ? new_of->array_(arr->count()) : type;
+    }
+
+    subst.emplace(type, result);
+    return result;
+}
+
+size_t Struct::TypeListHash::operator()(const std::vector<Type*>& types) const {
+    auto hash = types.size();
+
+    for (auto type : types) {
+        hash ^= std::hash<Type*>{}(type) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+    }
+
+    return hash;
+}
+
+void Struct::forget_instance() {
+    if (m_template_source == nullptr) {
+        return;
+    }
+
+    auto& instances = m_template_source->m_instances;
+
+    if (auto search = instances.find(m_template_args); search != instances.end() && search->second == this) {
+        instances.erase(search);
     }
-    return type;
 }
 
 Struct* Struct::instantiate(const std::vector<Type*>& args) {
@@ -112,8 +641,16 @@ Struct* Struct::instantiate(const std::vector<Type*>& args) {
         return nullptr;
     }
 
+    // Create the instantiated struct in the same owner
+    auto owner = m_owner;
+    if (!owner) return nullptr;
+
+    if (auto search = m_instances.find(args); search != m_instances.end() && search->second->m_owner == owner) {
+        return search->second;
+    }
+
     // Build substitution map
-    std::unordered_map<TemplateParameter*, Type*> subst;
+    std::unordered_map<Type*, Type*> subst;
     for (size_t i = 0; i < m_template_params.size(); ++i) {
         subst[m_template_params[i]] = args[i];
     }
@@ -130,10 +667,6 @@ Struct* Struct::instantiate(const std::vector<Type*>& args) {
     }
     inst_name += ">";
 
-    // Create the instantiated struct in the same owner
-    auto owner = m_owner;
-    if (!owner) return nullptr;
-
     // Check if already instantiated
     if (auto existing = owner->find<Struct>(inst_name)) {
         return existing;
@@ -141,10 +674,10 @@ Struct* Struct::instantiate(const std::vector<Type*>& args) {
 
     // Preserve the dynamic type (Class vs Struct)
     std::unique_ptr<Struct> instantiated;
-    if (dynamic_cast<const Class*>(this) != nullptr) {
-        instantiated = std::make_unique<Class>(inst_name);
+    if (is_a<Class>()) {
+        instantiated = owner->make<Class>(inst_name);
     } else {
-        instantiated = std::make_unique<Struct>(inst_name);
+        instantiated = owner->make<Struct>(inst_name);
     }
     auto inst = owner->add(std::move(instantiated));
 
@@ -239,6 +772,8 @@ Struct* Struct::instantiate(const std::vector<Type*>& args) {
     // Instantiated structs don't generate their own header — the C++ template handles it
     inst->skip_generation(true);
     inst->m_template_source = this;
+    inst->m_template_args = args;
+    m_instances.insert_or_assign(args, inst);
 
     return inst;
 }
@@ -250,19 +785,27 @@ const std::vector<Struct*>& Struct::parents() const {
 Struct* Struct::parent(Struct* parent) {
     if (std::find(m_parents.begin(), m_parents.end(), parent) == m_parents.end()) {
         m_parents.emplace_back(parent);
+        parent->add_size_dependent(this);
+        size_changed();
+        vtables_changed();
+        dependencies_changed();
     }
 
     return this;
 }
 
 size_t Struct::size() const {
+    if (m_cached_size != UNKNOWN_SIZE) {
+        return m_cached_size;
+    }
+
     size_t size = 0;
 
     for (auto&& parent : m_parents) {
         size += parent->size();
     }
 
-    for (auto&& var : get_all<Variable>()) {
+    for (auto&& var : child_view<Variable>()) {
         auto var_end = var->end();
 
         if (var_end > size) {
@@ -274,7 +817,7 @@ size_t Struct::size() const {
         size += sizeof(uintptr_t);
     }
 
-    return std::max<size_t>(size, m_size);
+    return m_cached_size = std::max<size_t>(size, m_size);
 }
 
 void Struct::generate_forward_decl(std::ostream& os) const {
@@ -315,6 +858,18 @@ void Struct::generate(std::ostream& os) const {
 }
 
 Struct::Dependencies Struct::dependencies() {
+    if (m_sdk != nullptr && m_sdk->dependency_graph_is_current()) {
+        auto& graph = m_sdk->m_dependency_graph;
+
+        if (auto search = graph.find(this); search != graph.end()) {
+            return search->second;
+        }
+    }
+
+    return collect_dependencies({});
+}
+
+Struct::Dependencies Struct::collect_dependencies(const DependencyGraph& graph) {
     Dependencies deps{};
 
     std::function<void(Object*)> add_dep{};
@@ -327,7 +882,7 @@ Struct::Dependencies Struct::dependencies() {
             // Structs declared within structs need their parent struct to be a hard dependency.
             add_hard_dep(parent);
         } else if (obj->is_a<Struct>() || obj->is_a<Enum>()) {
-            deps.hard.emplace(dynamic_cast<Type*>(obj));
+            deps.hard.emplace(obj->as<Type>());
         }
     };
     std::function<void(Object*)> add_soft_dep = [&](Object* obj) {
@@ -335,7 +890,7 @@ Struct::Dependencies Struct::dependencies() {
             return;
         }
 
-        if (auto ref = dynamic_cast<Reference*>(obj)) {
+        if (auto ref = obj->as<Reference>()) {
             add_soft_dep(ref->to());
         } else if (obj->is_a<Struct>() || obj->is_a<Enum>() || obj->is_a<GenericType>()) {
             if (obj->is_a<Enum>()) {
@@ -348,18 +903,22 @@ Struct::Dependencies Struct::dependencies() {
                 // Structs declared within structs need their parent struct to be a hard dependency.
                 add_hard_dep(parent);
             } else {
-                deps.soft.emplace(dynamic_cast<Type*>(obj));
+                deps.soft.emplace(obj->as<Type>());
             }
         }
     };
     add_dep = [&](Object* obj) {
-        if (auto arr = dynamic_cast<Array*>(obj)) {
+        if (obj == nullptr) {
+            return;
+        }
+
+        if (auto arr = obj->as<Array>()) {
             add_dep(arr->of());
-        } else if (auto gt = dynamic_cast<GenericType*>(obj)) {
+        } else if (auto gt = obj->as<GenericType>()) {
             for (auto&& type : gt->template_types()) {
                 add_dep(type);
             }
-        } else if (auto ref = dynamic_cast<Reference*>(obj)) {
+        } else if (auto ref = obj->as<Reference>()) {
             add_soft_dep(ref->to());
         } else {
             add_hard_dep(obj);
@@ -370,24 +929,26 @@ Struct::Dependencies Struct::dependencies() {
         add_hard_dep(parent);
     }
 
-    for (auto&& var : get_all<Variable>()) {
+    for (auto&& var : child_view<Variable>()) {
         add_dep(var->type());
     }
 
-    for (auto&& var : get_all<Constant>()) {
+    for (auto&& var : child_view<Constant>()) {
         add_dep(var->type());
     }
 
-    for (auto&& fn : get_all<Function>()) {
-        for (auto&& param : fn->get_all<Parameter>()) {
+    for (auto&& fn : child_view<Function>()) {
+        for (auto&& param : fn->child_view<Parameter>()) {
             add_dep(param->type());
         }
 
         add_dep(fn->returns());
     }
 
-    for (auto&& s : get_all<Struct>()) {
-        auto s_deps = s->dependencies();
+    for (auto&& s : child_view<Struct>()) {
+        Dependencies nested_deps{};
+        auto search = graph.find(s);
+        auto& s_deps = search != graph.end() ? search->second : (nested_deps = s->collect_dependencies(graph));
 
         for (auto&& dep : s_deps.hard) {
             add_hard_dep(dep);
@@ -408,16 +969,18 @@ Struct::Dependencies Struct::dependencies() {
     return deps;
 }
 
-int Struct::vtable_size() const {
+const std::vector<VirtualFunction*>& Struct::vtable() const {
+    if (m_sdk != nullptr && m_vtable_revision == m_sdk->m_vtable_revision) {
+        return m_vtable;
+    }
+
     auto max_index = -1;
 
     if (!m_parents.empty()) {
         max_index = 0;
 
         for (auto&& parent : m_parents) {
-            if (auto parent_vtable_size = parent->vtable_size(); parent_vtable_size != -1) {
-                max_index += parent_vtable_size;
-            }
+            max_index += (int)parent->vtable().size();
         }
 
         if (max_index == 0) {
@@ -425,11 +988,30 @@ int Struct::vtable_size() const {
         }
     }
 
-    for (auto&& child : get_all<VirtualFunction>()) {
+    for (auto&& child : child_view<VirtualFunction>()) {
         max_index = std::max<int>(max_index, child->vtable_index());
     }
 
-    return max_index + 1;
+    m_vtable.assign(max_index + 1, nullptr);
+
+    auto inherited = m_vtable.begin();
+
+    for (auto&& parent : m_parents) {
+        inherited = std::ranges::copy(parent->vtable(), inherited).out;
+    }
+
+    // Later declarations win a slot over earlier ones.
+    for (auto&& child : child_view<VirtualFunction>()) {
+        if (auto index = (int)child->vtable_index(); index >= 0) {
+            m_vtable[index] = child;
+        }
+    }
+
+    if (m_sdk != nullptr) {
+        m_vtable_revision = m_sdk->m_vtable_revision;
+    }
+
+    return m_vtable;
 }
 
 void Struct::generate_inheritance(std::ostream& os) const {
@@ -456,8 +1038,17 @@ void Struct::generate_inheritance(std::ostream& os) const {
 void Struct::generate_bitfield(std::ostream& os, uintptr_t offset) const {
     uintptr_t last_bit = 0;
     Type* bitfield_type{};
+    auto group = layout_group(offset);
+
+    for (auto it = group.begin(); it != group.end(); ++it) {
+        auto var = *it;
+        auto bit_offset = var->bit_offset();
+
+        // Only the latest declared of the variables sharing a bit offset is emitted.
+        if (auto next = std::next(it); next != group.end() && (*next)->bit_offset() == bit_offset) {
+            continue;
+        }
 
-    for (auto&& [bit_offset, var] : bitfield(offset)) {
         if (bit_offset - last_bit > 0) {
             os << "private: ";
             var->type()->generate_typename_for(os, var);
@@ -486,17 +1077,17 @@ void Struct::generate_bitfield(std::ostream& os, uintptr_t offset) const {
 void Struct::generate_internal(std::ostream& os) const {
     detail::Indent _{os};
 
-    for (auto&& child : get_all<Enum>()) {
+    for (auto&& child : child_view<Enum>()) {
         child->generate(os);
         os << "\n";
     }
 
-    for (auto&& child : get_all<Struct>()) {
+    for (auto&& child : child_view<Struct>()) {
         child->generate(os);
         os << "\n";
     }
 
-    for (auto&& child : get_all<Constant>()) {
+    for (auto&& child : child_view<Constant>()) {
         child->generate(os);
         os << "\n";
     }
@@ -520,7 +1111,7 @@ void Struct::generate_internal(std::ostream& os) const {
 
         bool has_unknown_size_field = false;
         std::unordered_set<uintptr_t> emitted_bitfield_offsets{};
-        for (auto&& var : get_all<Variable>()) {
+        for (auto&& var : child_view<Variable>()) {
             // Emit padding before variables with explicit @ offsets,
             // but only if we haven't seen a size-0 field — after one, we can't
             // compute correct padding since T's size is unknown.
@@ -571,12 +1162,10 @@ void Struct::generate_internal(std::ostream& os) const {
                << "]; public:\n";
         }
     } else {
-        std::unordered_map<std::uintptr_t, Variable*> var_map{};
-
-        for (auto&& var : get_all<Variable>()) {
-            var_map[var->offset()] = var;
-        }
-
+        // Walk the layout index instead of every byte, jumping from one field's offset to the next.
+        auto fields = m_layout != nullptr ? std::ranges::subrange{m_layout->cbegin(), m_layout->cend()}
+                                          : std::ranges::subrange<Layout::const_iterator>{};
+        auto next = fields.begin();
         auto max_offset = size();
         size_t offset = 0;
 
@@ -597,32 +1186,46 @@ void Struct::generate_internal(std::ostream& os) const {
         auto last_offset = offset;
 
         while (offset < max_offset) {
-            if (auto search = var_map.find(offset); search != var_map.end()) {
-                auto var = search->second;
-
-                // Skip variables where the user has not given us a valid size (forgot to set a type or the type is
-                // unfinished).
-                if (var->size() == 0) {
-                    ++offset;
-                    continue;
-                }
+            while (next != fields.end() && (*next)->offset() < offset) {
+                ++next;
+            }
 
-                if (offset - last_offset > 0) {
-                    os << "private: char pad_" << std::hex << last_offset << "[0x" << std::hex << offset - last_offset
-                       << "]; public:\n";
-                }
+            if (next == fields.end() || (*next)->offset() >= max_offset) {
+                offset = max_offset;
+                break;
+            }
 
-                if (var->is_bitfield()) {
-                    generate_bitfield(os, offset);
-                } else {
-                    var->generate(os);
-                }
+            offset = (*next)->offset();
 
-                offset += var->size();
-                last_offset = offset;
-            } else {
+            auto group_end = next;
+
+            while (group_end != fields.end() && (*group_end)->offset() == offset) {
+                ++group_end;
+            }
+
+            // Of the variables sharing an offset, the latest declared one is laid out.
+            auto var = latest_declared(next, group_end, nullptr);
+
+            // Skip variables where the user has not given us a valid size (forgot to set a type or the type is
+            // unfinished).
+            if (var->size() == 0) {
                 ++offset;
+                continue;
             }
+
+            if (offset - last_offset > 0) {
+                os << "private: char pad_" << std::hex << last_offset << "[0x" << std::hex << offset - last_offset
+                   << "]; public:\n";
+            }
+
+            if (var->is_bitfield()) {
+                generate_bitfield(os, offset);
+            } else {
+                var->generate(os);
+            }
+
+            offset += var->size();
+            last_offset = offset;
         }
 
         if (offset - last_offset > 0) {
@@ -633,7 +1236,7 @@ void Struct::generate_internal(std::ostream& os) const {
 
     if (has_any<Function>()) {
         // Generate normal functions normally.
-        for (auto&& child : get_all<Function>()) {
+        for (auto&& child : child_view<Function>()) {
             if (!child->is_a<VirtualFunction>()) {
                 child->generate(os);
             }
@@ -641,20 +1244,12 @@ void Struct::generate_internal(std::ostream& os) const {
     }
 
     if (has_any<VirtualFunction>()) {
-        std::unordered_map<int, VirtualFunction*> vtable{};
-
-        for (auto&& child : get_all<VirtualFunction>()) {
-            auto vtable_index = child->vtable_index();
-
-            vtable[vtable_index] = child;
-        }
-
-        auto vtable_index = 0;
-        auto vtbl_size = vtable_size();
+        auto& slots = vtable();
 
-        for (; vtable_index < vtbl_size; ++vtable_index) {
-            if (auto search = vtable.find(vtable_index); search != vtable.end()) {
-                search->second->generate(os);
+        for (auto vtable_index = 0; vtable_index < (int)slots.size(); ++vtable_index) {
+            // Inherited slots aren't redeclared.
+            if (auto fn = slots[vtable_index]; fn != nullptr && fn->direct_owner() == this) {
+                fn->generate(os);
             } else {
                 // Generate a default destructor to force addition of the vtable ptr.
                 if (vtable_index == 0) {
@@ -2,6 +2,8 @@
 
 namespace sdkgenny {
 TemplateParameter::TemplateParameter(std::string_view name) : Type{name} {
+    m_kind |= detail::KIND_TEMPLATE_PARAMETER;
+
     // Template parameters have no concrete size — they are placeholders.
     // Mark skip_generation so they don't appear in output.
     skip_generation(true);
@@ -1,22 +1,168 @@
 #include <sdkgenny/array.hpp>
 #include <sdkgenny/pointer.hpp>
 #include <sdkgenny/reference.hpp>
+#include <sdkgenny/sdk.hpp>
 
 #include <sdkgenny/type.hpp>
 
 namespace sdkgenny {
 Type::Type(std::string_view name) : Typename{name} {
+    m_kind |= detail::KIND_TYPE;
+}
+
+Type::~Type() {
+    // A type made later at the same address mustn't be handed the ones made from this one.
+    if (m_owner != nullptr && m_owner->m_derived_types != nullptr) {
+        m_owner->m_derived_types->index.erase(this);
+    }
+
+    if (m_size_links == nullptr) {
+        return;
+    }
+
+    // Nested types may be linked to this one so they have to unlink while it's still around.
+    m_children.clear();
+
+    // Everything goes away at once when the Sdk is destroyed so there's no one left to unlink from (the Sdk unlinks us
+    // from any types outside of it beforehand).
+    if (m_sdk == nullptr || !m_sdk->m_is_being_destroyed) {
+        for (auto&& dependency : m_size_links->dependencies) {
+            std::erase(dependency->m_size_links->dependents, this);
+        }
+
+        for (auto&& dependent : m_size_links->dependents) {
+            std::erase(dependent->m_size_links->dependencies, this);
+        }
+    }
+
+    std::pmr::polymorphic_allocator<>{m_size_links->dependents.get_allocator()}.delete_object(m_size_links);
+}
+
+void Type::add_size_dependent(Type* dependent) {
+    // Checked against the dependent's side since a type depends on a few others while many may depend on it.
+    auto& dependencies = dependent->size_links().dependencies;
+
+    if (std::ranges::find(dependencies, this) != dependencies.end()) {
+        return;
+    }
+
+    dependencies.emplace_back(this);
+    size_links().dependents.emplace_back(dependent);
+
+    if (m_sdk != dependent->m_sdk) {
+        for (auto sdk : {m_sdk, dependent->m_sdk}) {
+            if (sdk != nullptr) {
+                sdk->m_has_foreign_size_links = true;
+            }
+        }
+    }
+}
+
+void Type::remove_size_dependent(Type* dependent) {
+    if (m_size_links == nullptr || dependent->m_size_links == nullptr) {
+        return;
+    }
+
+    std::erase(m_size_links->dependents, dependent);
+    std::erase(dependent->m_size_links->dependencies, this);
+}
+
+void Type::size_changed() {
+    // A cached size that is already gone means everything derived from it was dropped along with it, since computing
+    // any of those would have cached it again.
+    if ((m_kind & (detail::KIND_STRUCT | detail::KIND_ARRAY)) != 0) {
+        if (m_cached_size == UNKNOWN_SIZE) {
+            return;
+        }
+
+        if (auto s = as<Struct>()) {
+            s->m_field_index.reset();
+
+            if (s->m_size_before_edits == UNKNOWN_SIZE) {
+                s->m_size_before_edits = m_cached_size;
+            }
+        }
+
+        m_cached_size = UNKNOWN_SIZE;
+    }
+
+    if (m_size_links != nullptr) {
+        for (auto&& dependent : m_size_links->dependents) {
+            dependent->size_changed();
+        }
+    }
+}
+
+Type::SizeLinks& Type::size_links() {
+    if (m_size_links == nullptr) {
+        m_size_links = std::pmr::polymorphic_allocator<>{resource()}.new_object<SizeLinks>();
+    }
+
+    return *m_size_links;
+}
+
+template <typename T> T* Type::derived(size_t count) {
+    if (m_owner->m_derived_types == nullptr) {
+        m_owner->m_derived_types = std::make_unique<DerivedTypes>();
+    }
+
+    auto& types = *m_owner->m_derived_types;
+    auto& made = types.index[this];
+    auto is_match = [&](const DerivedType& derived) {
+        return derived.kind == detail::kind_of<T> && derived.count == count;
+    };
+
+    if (auto search = std::ranges::find_if(made, is_match); search != made.end()) {
+        auto type = (T*)search->type;
+
+        // Unless somebody has repointed or resized it since.
+        if constexpr (std::is_same_v<T, Array>) {
+            if (type->of() == this && type->count() == count) {
+                return type;
+            }
+        } else if (type->to() == this) {
+            return type;
+        }
+    }
+
+    std::string derived_name{name()};
+
+    if constexpr (std::is_same_v<T, Array>) {
+        derived_name += "[0]";
+    } else {
+        derived_name += std::is_same_v<T, Pointer> ? '*' : '&';
+    }
+
+    auto type = m_owner->make<T>(derived_name);
+    auto p = type.get();
+
+    p->m_owner = m_owner;
+    p->relink();
+    types.owned.emplace_back(std::move(type));
+    std::erase_if(made, is_match);
+    made.emplace_back(DerivedType{detail::kind_of<T>, count, p});
+
+    // An array's name only gets its count once it knows what it's an array of.
+    if constexpr (std::is_same_v<T, Array>) {
+        p->of(this)->count(count);
+    } else {
+        p->to(this);
+    }
+
+    m_owner->structure_changed();
+
+    return p;
 }
 
 Reference* Type::ref() {
-    return m_owner->find_or_add<Reference>(name() + '&')->to(this);
+    return derived<Reference>(0);
 }
 
 Pointer* Type::ptr() {
-    return (Pointer*)m_owner->find_or_add<Pointer>(name() + '*')->to(this);
+    return derived<Pointer>(0);
 }
 
 Array* Type::array_(size_t count) {
-    return m_owner->find_or_add<Array>(name() + "[0]")->of(this)->count(count);
+    return derived<Array>(count);
 }
 } // namespace sdkgenny
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 namespace sdkgenny {
 Typename::Typename(std::string_view name) : Object{name} {
+    m_kind |= detail::KIND_TYPENAME;
 }
 
 void Typename::generate_typename_for(std::ostream& os, const Object* obj) const {
@@ -1,60 +1,97 @@
 #include <climits>
+#include <utility>
 
 #include <sdkgenny/struct.hpp>
 
 #include <sdkgenny/variable.hpp>
 
 namespace sdkgenny {
-Variable* Variable::append() {
-    auto struct_ = owner<Struct>();
-    uintptr_t highest_offset{};
-    Variable* highest_var{};
+Variable* Variable::type(Type* type) {
+    auto old_type = std::exchange(m_type, type);
+
+    dependencies_changed();
 
-    for (auto&& var : struct_->get_all<Variable>()) {
-        if (var->offset() >= highest_offset && var != this) {
-            highest_offset = var->offset();
-            highest_var = var;
+    if (auto struct_ = owner<Struct>()) {
+        if (old_type != nullptr && old_type != type) {
+            struct_->size_dependency_released(old_type);
         }
+
+        if (type != nullptr) {
+            type->add_size_dependent(struct_);
+        }
+
+        struct_->size_changed();
+    }
+
+    return this;
+}
+
+Variable* Variable::offset(uintptr_t offset) {
+    m_offset_is_explicit = true;
+    m_offset_is_appended = false;
+
+    if (auto struct_ = owner<Struct>()) {
+        struct_->relayout(this, [&] { m_offset = offset; });
+        struct_->size_changed();
+    } else {
+        m_offset = offset;
     }
 
+    return this;
+}
+
+Variable* Variable::bit_offset(uintptr_t offset) {
+    // assert(offset < m_type->size() * CHAR_BIT);
+    m_bit_offset_is_appended = false;
+
+    if (auto struct_ = owner<Struct>()) {
+        struct_->relayout(this, [&] { m_bit_offset = offset; });
+    } else {
+        m_bit_offset = offset;
+    }
+
+    return this;
+}
+
+Variable* Variable::append() {
+    auto struct_ = owner<Struct>();
+    auto offset = appended_offset(struct_);
+
+    m_offset_is_appended = true;
+    struct_->relayout(this, [&] { m_offset = offset; });
+    struct_->size_changed();
+
+    return this;
+}
+
+uintptr_t Variable::appended_offset(const Struct* struct_) const {
+    auto highest_var = struct_->layout_tail(this);
+    uintptr_t offset{};
+
     if (highest_var != nullptr) {
         // Both bitfields of the same type.
         if (is_bitfield() && highest_var->is_bitfield() && m_type == highest_var->type()) {
-            uintptr_t highest_bit = 0;
-            auto bf = struct_->bitfield(highest_var->offset(), this);
-
-            for (auto&& [bit_offset, bit_var] : bf) {
-                if (bit_offset >= highest_bit && bit_var != this) {
-                    highest_bit = bit_offset;
-                    highest_var = bit_var;
-                }
-            }
+            highest_var = struct_->bitfield_tail(highest_var->offset(), this);
 
             auto end_bit = highest_var->bit_offset() + highest_var->bit_size();
 
             if (end_bit + m_bit_size <= m_type->size() * CHAR_BIT) {
                 // Squeeze into the remainign bits.
-                m_offset = highest_var->offset();
+                offset = highest_var->offset();
             } else {
                 // Not enough room, so start where the previous bitfield ended.
-                m_offset = highest_var->end();
+                offset = highest_var->end();
             }
         } else {
-            m_offset = highest_var->end();
+            offset = highest_var->end();
         }
     } else if (auto parents = struct_->parents(); !parents.empty()) {
-        size_t size{};
-
         for (auto&& parent : parents) {
-            size += parent->size();
+            offset += parent->size();
         }
-
-        m_offset = size;
-    } else {
-        m_offset = 0;
     }
 
-    return this;
+    return offset;
 }
 
 size_t Variable::size() const {
@@ -67,26 +104,20 @@ size_t Variable::size() const {
 
 Variable* Variable::bit_append() {
     auto struct_ = owner<Struct>();
-    uintptr_t highest_bit{};
-    Variable* highest_var{};
-    auto bf = struct_->bitfield(m_offset, this);
-
-    for (auto&& [bit_offset, bit_var] : bf) {
-        if (bit_offset >= highest_bit && bit_var != this) {
-            highest_bit = bit_offset;
-            highest_var = bit_var;
-        }
-    }
+    auto bit_offset = appended_bit_offset(struct_);
 
-    if (highest_var != nullptr) {
-        auto end_bit = highest_var->bit_offset() + highest_var->bit_size();
+    m_bit_offset_is_appended = true;
+    struct_->relayout(this, [&] { m_bit_offset = bit_offset; });
 
-        m_bit_offset = end_bit;
-    } else {
-        m_bit_offset = 0;
+    return this;
+}
+
+uintptr_t Variable::appended_bit_offset(const Struct* struct_) const {
+    if (auto highest_var = struct_->bitfield_tail(m_offset, this); highest_var != nullptr) {
+        return highest_var->bit_offset() + highest_var->bit_size();
     }
 
-    return this;
+    return 0;
 }
 
 void Variable::generate(std::ostream& os) const {
@@ -2,6 +2,13 @@
 
 namespace sdkgenny {
 VirtualFunction::VirtualFunction(std::string_view name) : Function{name} {
+    m_kind |= detail::KIND_VIRTUAL_FUNCTION;
+}
+
+VirtualFunction* VirtualFunction::vtable_index(uint32_t vtable_index) {
+    m_vtable_index = vtable_index;
+    vtables_changed();
+    return this;
 }
 
 void VirtualFunction::generate(std::ostream& os) const {
@@ -0,0 +1,72 @@
+// Objects removed from an Sdk, or made by it and never added, stay usable after the Sdk is destroyed since they keep
+// the arena they were allocated from alive.
+#include <memory>
+#include <string>
+
+#include <sdkgenny.hpp>
+
+#include "check.hpp"
+
+using sdkgenny::Namespace;
+using sdkgenny::Object;
+using sdkgenny::Struct;
+using sdkgenny::Type;
+using sdkgenny::Variable;
+
+int main() {
+    std::unique_ptr<Object> removed{};
+    std::unique_ptr<Struct> made{};
+
+    {
+        sdkgenny::Sdk sdk{};
+        auto ns = sdk.global_ns()->namespace_("game");
+        auto int_t = ns->type("int")->size(4);
+        auto s = ns->struct_("Foo");
+
+        // Enough children and fields for the name index and the layout to be allocated.
+        for (auto i = 0; i < 20; ++i) {
+            s->variable("v" + std::to_string(i))->type(int_t)->offset(i * 4);
+        }
+
+        s->variable("p")->type(int_t->ptr())->offset(80);
+        s->variable("a")->type(int_t->array_(2))->offset(88);
+
+        made = ns->make<Struct>("Made");
+        made->variable("x")->offset(4);
+
+        removed = sdk.global_ns()->remove(ns);
+    }
+
+    CHECK(removed->name() == "game");
+
+    auto ns = removed->as<Namespace>();
+    auto s = ns->find<Struct>("Foo");
+
+    CHECK(s != nullptr);
+    CHECK(s->name() == "Foo");
+    CHECK(s->size() == 96);
+    CHECK(s->find<Variable>("v13") != nullptr);
+    CHECK(s->field_at(52).back().var == s->find<Variable>("v13"));
+
+    auto int_t = ns->find<Type>("int");
+
+    CHECK(int_t->ptr() == s->find<Variable>("p")->type());
+    CHECK(int_t->array_(3)->size() == 12);
+
+    ns->struct_("Bar")->variable("y")->type(int_t);
+
+    CHECK(made->name() == "Made");
+    CHECK(made->find<Variable>("x")->offset() == 4);
+
+    // And may be added to another Sdk, outliving the one they came from.
+    {
+        sdkgenny::Sdk sdk{};
+
+        CHECK(sdk.global_ns()->add(std::move(removed)) == ns);
+        CHECK(sdk.global_ns()->find<Namespace>("game") == ns);
+        CHECK(ns->find<Struct>("Bar") != nullptr);
+        CHECK(s->size() == 96);
+    }
+
+    return 0;
+}
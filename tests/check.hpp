@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdio>
+
+// Each test is a main() that returns 1 from the first check that fails, after printing where it is.
+#define CHECK(expr)                                                                                                    \
+    if (!(expr)) {                                                                                                     \
+        std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr);                                           \
+        return 1;                                                                                                      \
+    }
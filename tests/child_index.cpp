@@ -0,0 +1,68 @@
+// The name index of an object with many children keeps finding children by name when children sharing a name are
+// removed, destroyed or renamed, whichever of them was added first.
+#include <memory>
+#include <string>
+
+#include <sdkgenny.hpp>
+
+#include "check.hpp"
+
+using sdkgenny::Enum;
+using sdkgenny::Namespace;
+using sdkgenny::Struct;
+
+static int check_duplicates(Namespace* ns) {
+    // Enough children for the index to be built.
+    for (auto i = 0; i < 16; ++i) {
+        ns->struct_("s" + std::to_string(i));
+    }
+
+    auto first = ns->add(ns->make<Enum>("dup"));
+    auto second = ns->add(ns->make<Enum>("dup"));
+
+    CHECK(ns->find<Enum>("dup") == first);
+
+    // The first one added is gone, so nothing may still depend on its name.
+    ns->remove(first);
+
+    CHECK(ns->find<Enum>("dup") == second);
+
+    auto third = ns->add(ns->make<Enum>("dup"));
+
+    second->name("renamed");
+
+    CHECK(ns->find<Enum>("dup") == third);
+    CHECK(ns->find<Enum>("renamed") == second);
+
+    // Both share a name again, in declaration order.
+    third->name("renamed");
+
+    CHECK(ns->find<Enum>("dup") == nullptr);
+    CHECK(ns->find<Enum>("renamed") == second);
+
+    second->name("other");
+
+    CHECK(ns->find<Enum>("renamed") == third);
+    CHECK(ns->find<Enum>("other") == second);
+
+    ns->remove(third);
+
+    CHECK(ns->find<Enum>("renamed") == nullptr);
+    CHECK(ns->find<Struct>("s15") != nullptr);
+
+    return 0;
+}
+
+int main() {
+    // Names owned by the objects themselves...
+    auto detached = std::make_unique<Namespace>("detached");
+
+    CHECK(check_duplicates(detached.get()) == 0);
+
+    // ...and names interned in an Sdk.
+    sdkgenny::Sdk sdk{};
+
+    CHECK(check_duplicates(sdk.global_ns()) == 0);
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+// Struct::compile_path() turns a field path into a FieldPlan whose resolve() finds the same address as the C++ it's
+// written like, folding "." and array indices into offsets and reading pointers for "->", "." and indices through
+// them. Paths naming nothing, indexing out of bounds or not parsing give no plan at all.
+#include <cstddef>
+#include <cstdint>
+
+#include <sdkgenny.hpp>
+
+#include "check.hpp"
+
+using sdkgenny::Struct;
+
+namespace native {
+struct Item {
+    int count;
+    int flags;
+};
+
+struct Inventory {
+    Item items[4];
+};
+
+struct Vec {
+    float x, y, z;
+};
+
+struct Player {
+    int hp;
+    Vec pos;
+    Inventory* inv;
+    Item* items;
+};
+
+struct Npc : Player {
+    int ai;
+};
+} // namespace native
+
+static uintptr_t address_of(const void* p) {
+    return reinterpret_cast<uintptr_t>(p);
+}
+
+int main() {
+    sdkgenny::Sdk sdk{};
+    auto g = sdk.global_ns();
+    auto int_t = g->type("int")->size(sizeof(int));
+    auto float_t = g->type("float")->size(sizeof(float));
+
+    auto item = g->struct_("Item");
+
+    item->variable("count")->type(int_t)->offset(offsetof(native::Item, count));
+    item->variable("flags")->type(int_t)->offset(offsetof(native::Item, flags));
+
+    auto inventory = g->struct_("Inventory");
+
+    inventory->variable("items")->type(item->array_(4))->offset(offsetof(native::Inventory, items));
+
+    auto vec = g->struct_("Vec");
+
+    vec->variable("x")->type(float_t)->offset(offsetof(native::Vec, x));
+    vec->variable("y")->type(float_t)->offset(offsetof(native::Vec, y));
+    vec->variable("z")->type(float_t)->offset(offsetof(native::Vec, z));
+
+    auto player = g->struct_("Player");
+
+    player->variable("hp")->type(int_t)->offset(offsetof(native::Player, hp));
+    player->variable("pos")->type(vec)->offset(offsetof(native::Player, pos));
+    player->variable("inv")->type(inventory->ptr())->offset(offsetof(native::Player, inv));
+    player->variable("items")->type(item->ptr())->offset(offsetof(native::Player, items));
+
+    auto npc = g->struct_("Npc")->parent(player);
+
+    // Fields of a derived struct are at their offset within it, right after the parent here.
+    npc->variable("ai")->type(int_t)->offset(sizeof(native::Player));
+
+    CHECK(player->size() == sizeof(native::Player));
+
+    native::Inventory inv{};
+    native::Item items[3]{};
+    native::Npc p{};
+
+    p.inv = &inv;
+    p.items = items;
+
+    auto resolve = [&](const Struct* s, const char* path) -> uintptr_t {
+        auto plan = s->compile_path(path);
+
+        return plan ? plan->resolve(address_of(&p)) : ~uintptr_t{};
+    };
+
+    // Within the struct, folded into a single offset.
+    CHECK(resolve(player, "hp") == address_of(&p.hp));
+    CHECK(resolve(player, "pos.y") == address_of(&p.pos.y));
+    CHECK(player->compile_path("pos.z")->offsets.size() == 1);
+    CHECK(player->compile_path("pos.z")->var == vec->find<sdkgenny::Variable>("z"));
+
+    // Through pointers, with "->", "." and indices.
+    CHECK(resolve(player, "inv->items[2].count") == address_of(&inv.items[2].count));
+    CHECK(resolve(player, "inv.items[3].flags") == address_of(&inv.items[3].flags));
+    CHECK(resolve(player, "items[2].flags") == address_of(&items[2].flags));
+    CHECK(resolve(player, "items->count") == address_of(&items[0].count));
+    CHECK(player->compile_path("inv->items[1]")->offsets.size() == 2);
+
+    // Fields of the parents, from the derived struct.
+    CHECK(resolve(npc, "ai") == address_of(&p.ai));
+    CHECK(resolve(npc, "pos.x") == address_of(&p.pos.x));
+    CHECK(resolve(npc, "inv->items[0].count") == address_of(&inv.items[0].count));
+
+    // A null pointer along the way.
+    p.inv = nullptr;
+
+    CHECK(resolve(player, "inv->items[1].count") == 0);
+
+    // Out of bounds, unknown names and paths that don't parse.
+    for (auto path : {"inv->items[4]", "nope", "pos.w", "hp.x", "hp->x", "pos[0]", "", ".hp", "pos.", "pos..y",
+             "pos y", "inv->", "inv->>items", "items[", "items[]", "items[x]", "items[1", "items]1[", "hp;"}) {
+        CHECK(!player->compile_path(path).has_value());
+    }
+
+    // An empty plan resolves to nothing rather than reading past its offsets.
+    CHECK(Struct::FieldPlan{}.resolve(address_of(&p)) == 0);
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Struct::dependencies() returns what a struct needs defined (hard) or declared (soft) before it, staying correct as
+// the Sdk is edited between queries and valid however long it's kept.
+#include <filesystem>
+#include <memory>
+
+#include <sdkgenny.hpp>
+
+#include "check.hpp"
+
+using sdkgenny::Struct;
+
+int main() {
+    sdkgenny::Sdk sdk{};
+    auto g = sdk.global_ns();
+    auto int_t = g->type("int")->size(4);
+    auto a = g->struct_("A");
+    auto b = g->struct_("B");
+    auto c = g->struct_("C");
+    auto e = g->enum_("E");
+
+    a->variable("x")->type(int_t);
+    b->variable("a")->type(a);
+    b->variable("c")->type(c->ptr());
+    b->variable("e")->type(e);
+
+    const auto& deps = b->dependencies();
+
+    CHECK(deps.hard.size() == 2);
+    CHECK(deps.hard.contains(a));
+    CHECK(deps.hard.contains(e));
+    CHECK(deps.soft.size() == 1);
+    CHECK(deps.soft.contains(c));
+
+    // Edits between queries are picked up, and what was returned before is left alone.
+    b->variable("c")->type(c);
+    b->parent(g->struct_("Base"));
+
+    auto edited = b->dependencies();
+
+    CHECK(edited.hard.size() == 4);
+    CHECK(edited.hard.contains(c));
+    CHECK(edited.hard.contains(g->find<Struct>("Base")));
+    CHECK(edited.soft.empty());
+    CHECK(a->dependencies().hard.empty());
+
+    CHECK(deps.hard.size() == 2);
+    CHECK(deps.soft.contains(c));
+
+    // Nested structs contribute theirs to their owner's, and need their owner themselves.
+    auto d = g->struct_("D");
+    auto nested = d->struct_("Nested");
+
+    nested->variable("a")->type(a);
+    nested->variable("b")->type(b->ptr());
+
+    auto d_deps = d->dependencies();
+
+    CHECK(d_deps.hard.contains(a));
+    CHECK(d_deps.soft.contains(b));
+
+    g->struct_("F")->variable("n")->type(nested);
+
+    CHECK(g->find<Struct>("F")->dependencies().hard.contains(d));
+
+    // The same answers once generation has built the graph for every struct at once.
+    auto root = std::filesystem::temp_directory_path() / "sdkgenny_test_dependencies";
+
+    std::filesystem::remove_all(root);
+    sdk.generate(root);
+    std::filesystem::remove_all(root);
+
+    CHECK(b->dependencies().hard.size() == 4);
+    CHECK(b->dependencies().hard.contains(c));
+    CHECK(d->dependencies().soft.contains(b));
+
+    // And for structs outside of any Sdk.
+    auto ns = std::make_unique<sdkgenny::Namespace>("ns");
+    auto s = ns->struct_("S");
+
+    s->variable("t")->type(ns->struct_("T"));
+
+    CHECK(s->dependencies().hard.contains(ns->find<Struct>("T")));
+
+    return 0;
+}
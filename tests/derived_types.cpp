@@ -0,0 +1,102 @@
+// Type::ptr(), ref() and array_() hand out one type per base type, kind and count, kept out of their owner's children
+// and forgotten once the base type is removed.
+#include <memory>
+
+#include <sdkgenny.hpp>
+
+#include "check.hpp"
+
+using sdkgenny::Array;
+using sdkgenny::Pointer;
+using sdkgenny::Reference;
+using sdkgenny::Type;
+
+int main() {
+    {
+        sdkgenny::Sdk sdk{};
+        auto g = sdk.global_ns();
+        auto int_t = g->type("int")->size(4);
+
+        CHECK(int_t->ptr() == int_t->ptr());
+        CHECK(int_t->ref() == int_t->ref());
+        CHECK(int_t->array_(4) == int_t->array_(4));
+        CHECK((Type*)int_t->ptr() != int_t->ref());
+        CHECK(int_t->array_(4) != int_t->array_(8));
+        CHECK(int_t->array_(4) != int_t->array_());
+        CHECK(int_t->ptr()->ptr() == int_t->ptr()->ptr());
+
+        CHECK(int_t->ptr()->name() == "int*");
+        CHECK(int_t->ref()->name() == "int&");
+        CHECK(int_t->array_(4)->name() == "int[4]");
+        CHECK(int_t->ptr()->ptr()->name() == "int**");
+        CHECK(int_t->array_(4)->size() == 16);
+
+        // They aren't children of the owner.
+        CHECK(g->find<Pointer>("int*") == nullptr);
+        CHECK(g->get_all<Type>().size() == 1);
+
+        // One that was repointed or resized since is replaced.
+        auto char_t = g->type("char")->size(1);
+        auto ptr = int_t->ptr();
+        auto arr = int_t->array_(2);
+
+        ptr->to(char_t);
+        arr->count(3);
+
+        CHECK(int_t->ptr() != ptr);
+        CHECK(int_t->ptr()->to() == int_t);
+        CHECK(int_t->array_(2) != arr);
+        CHECK(int_t->array_(2)->count() == 2);
+        CHECK(int_t->array_(3) == int_t->array_(3));
+
+        // Removing the base type drops its entries, so adding it back makes new ones.
+        auto float_t = g->type("float")->size(4);
+        auto float_ptr = float_t->ptr();
+        auto float_arr = float_t->array_(4);
+        auto removed = g->remove(float_t);
+
+        CHECK(removed != nullptr);
+        CHECK(g->add(std::move(removed)) == float_t);
+        CHECK(float_t->ptr() != float_ptr);
+        CHECK(float_t->array_(4) != float_arr);
+        CHECK(float_t->ptr()->to() == float_t);
+
+        // Same for one removed and destroyed: its replacement starts without any.
+        g->remove(float_t);
+
+        auto double_t = g->type("double")->size(8);
+
+        CHECK(double_t->ptr()->to() == double_t);
+        CHECK(double_t->array_(4)->of() == double_t);
+        CHECK(double_t->array_(4)->size() == 32);
+
+        // Through remove_if() as well.
+        auto short_t = g->type("short")->size(2);
+        auto short_ref = short_t->ref();
+
+        CHECK(g->remove_if([&](sdkgenny::Object* child) { return child == short_t; }).size() == 1);
+        CHECK(g->find<Type>("short") == nullptr);
+        CHECK(g->type("short")->ref() != short_ref);
+    }
+
+    // Types made from the Sdk's own children go before the Sdk's arena does.
+    {
+        sdkgenny::Sdk sdk{};
+        auto int_t = sdk.find_or_add<Type>("int")->size(4);
+
+        int_t->ptr();
+        int_t->ref();
+        int_t->array_(2);
+    }
+
+    // And from types outside of any Sdk.
+    {
+        auto ns = std::make_unique<sdkgenny::Namespace>("ns");
+        auto int_t = ns->type("int")->size(4);
+
+        CHECK(int_t->ptr() == int_t->ptr());
+        CHECK(int_t->array_(3)->size() == 12);
+    }
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+// Objects removed from an Sdk take their names with them rather than pointing into the Sdk's string pool, and pick up
+// the pool of whichever Sdk they're added to next.
+#include <memory>
+
+#include <sdkgenny.hpp>
+
+#include "check.hpp"
+
+using sdkgenny::Namespace;
+using sdkgenny::Object;
+using sdkgenny::Struct;
+
+int main() {
+    std::unique_ptr<Object> removed{};
+
+    {
+        sdkgenny::Sdk sdk{};
+        auto g = sdk.global_ns();
+
+        // Allocated on the heap, so nothing but their names tie them to the Sdk.
+        auto ns = g->add(std::make_unique<Namespace>("heap"));
+
+        ns->add(std::make_unique<Struct>("Foo"));
+        removed = g->remove(ns);
+    }
+
+    CHECK(removed->name() == "heap");
+    CHECK(removed->as<Namespace>()->find<Struct>("Foo")->name() == "Foo");
+
+    removed->name("renamed");
+
+    CHECK(removed->name() == "renamed");
+
+    // Made by one Sdk and added to another.
+    std::unique_ptr<Struct> made{};
+
+    {
+        sdkgenny::Sdk sdk{};
+
+        made = sdk.global_ns()->make<Struct>("Made");
+    }
+
+    // Back in an Sdk, their names are found through its pool again.
+    sdkgenny::Sdk sdk{};
+    auto g = sdk.global_ns();
+    auto ns = g->add(std::move(removed));
+    auto s = g->add(std::move(made));
+
+    CHECK(g->find<Namespace>("renamed") == ns);
+    CHECK(g->find<Struct>("Made") == s);
+    CHECK(ns->find<Struct>("Foo") != nullptr);
+    CHECK(&s->name() == &sdk.string_pool()->intern("Made"));
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+// Struct::field_at() resolves an offset to the chain of fields holding it, through parents, by-value structs and array
+// elements, and keeps doing so as fields are moved and retyped. Struct::field_path() formats the chain.
+#include <string>
+#include <vector>
+
+#include <sdkgenny.hpp>
+
+#include "check.hpp"
+
+using sdkgenny::Struct;
+using sdkgenny::Variable;
+
+// The fields of the chain at offset, outermost first.
+static std::vector<Variable*> vars_at(const Struct* s, uintptr_t offset) {
+    std::vector<Variable*> vars{};
+
+    for (auto&& location : s->field_at(offset)) {
+        vars.emplace_back(location.var);
+    }
+
+    return vars;
+}
+
+static std::string path_at(const Struct* s, uintptr_t offset) {
+    return Struct::field_path(s->field_at(offset));
+}
+
+int main() {
+    sdkgenny::Sdk sdk{};
+    auto g = sdk.global_ns();
+    auto int_t = g->type("int")->size(4);
+    auto float_t = g->type("float")->size(4);
+    auto long_t = g->type("long")->size(8);
+
+    auto vec3 = g->struct_("Vec3");
+    auto x = vec3->variable("x")->type(float_t)->offset(0);
+    auto y = vec3->variable("y")->type(float_t)->offset(4);
+
+    vec3->variable("z")->type(float_t)->offset(8);
+
+    auto transform = g->struct_("Transform");
+    auto pos = transform->variable("pos")->type(vec3)->offset(0);
+    auto rot = transform->variable("rot")->type(vec3->array_(2))->offset(12);
+
+    auto base = g->struct_("Base");
+    auto id = base->variable("id")->type(int_t)->offset(0);
+    auto flags = base->variable("flags")->type(int_t)->offset(4);
+
+    auto entity = g->struct_("Entity")->parent(base);
+    auto entity_transform = entity->variable("transform")->type(transform)->offset(8);
+    auto grid = entity->variable("grid")->type(int_t->array_(3)->array_(2))->offset(44);
+
+    CHECK(entity->size() == 68);
+
+    // Fields of the parents, at the offsets they have within the parents.
+    CHECK(vars_at(entity, 2) == std::vector<Variable*>{id});
+    CHECK(vars_at(entity, 6) == std::vector<Variable*>{flags});
+    CHECK(entity->field_at(6)[0].offset == 4);
+    CHECK(path_at(entity, 6) == "Base::flags");
+
+    // Through by-value structs and arrays of them, with offsets relative to the struct queried.
+    auto chain = entity->field_at(36);
+
+    CHECK(chain.size() == 3);
+    CHECK(chain[0].var == entity_transform && chain[0].offset == 8 && chain[0].indices.empty());
+    CHECK(chain[1].var == rot && chain[1].offset == 20 && chain[1].indices == std::vector<size_t>{1});
+    CHECK(chain[2].var == y && chain[2].offset == 36);
+    CHECK(path_at(entity, 36) == "Entity::transform.rot[1].y");
+    CHECK(vars_at(entity, 8) == (std::vector<Variable*>{entity_transform, pos, x}));
+
+    // Each dimension of a multi-dimensional array, outermost first.
+    chain = entity->field_at(44 + 12 + 8 + 1);
+
+    CHECK(chain.size() == 1);
+    CHECK(chain[0].var == grid && chain[0].offset == 44);
+    CHECK(chain[0].indices == (std::vector<size_t>{1, 2}));
+    CHECK(path_at(entity, 44 + 12 + 8 + 1) == "Entity::grid[1][2]");
+
+    // Past the end there's nothing.
+    CHECK(entity->field_at(68).empty());
+    CHECK(entity->field_at(1000).empty());
+
+    // Overlapping fields: the one starting closest to the offset wins, then the latest declared.
+    auto overlap = g->struct_("Overlap");
+    auto inner = overlap->variable("inner")->type(int_t)->offset(4);
+    auto outer = overlap->variable("outer")->type(long_t)->offset(0);
+    auto first = overlap->variable("first")->type(int_t)->offset(8);
+    auto second = overlap->variable("second")->type(int_t)->offset(8);
+
+    CHECK(vars_at(overlap, 2) == std::vector<Variable*>{outer});
+    CHECK(vars_at(overlap, 5) == std::vector<Variable*>{inner});
+    CHECK(vars_at(overlap, 9) == std::vector<Variable*>{second});
+    CHECK(first != second);
+
+    // Bitfields sharing a storage unit resolve to the latest declared one, with its bits.
+    auto bits = g->struct_("Bits");
+
+    bits->variable("lo")->type(int_t)->offset(0)->bit_size(3)->bit_offset(0);
+
+    auto hi = bits->variable("hi")->type(int_t)->offset(0)->bit_size(5)->bit_offset(3);
+
+    chain = bits->field_at(2);
+
+    CHECK(chain.size() == 1);
+    CHECK(chain[0].var == hi && chain[0].bit_offset == 3 && chain[0].bit_size == 5);
+
+    // Padding between fields and after the last one, up to an explicit size.
+    auto padded = g->struct_("Padded")->size(16);
+    auto a = padded->variable("a")->type(int_t)->offset(0);
+    auto b = padded->variable("b")->type(int_t)->offset(8);
+
+    CHECK(padded->field_at(5).empty());
+    CHECK(padded->field_at(14).empty());
+    CHECK(vars_at(padded, 9) == std::vector<Variable*>{b});
+
+    // The index follows edits to offsets and types.
+    b->offset(12);
+
+    CHECK(padded->field_at(9).empty());
+    CHECK(vars_at(padded, 13) == std::vector<Variable*>{b});
+
+    a->type(long_t);
+
+    CHECK(vars_at(padded, 5) == std::vector<Variable*>{a});
+
+    a->type(vec3);
+
+    CHECK(vars_at(padded, 9) == (std::vector<Variable*>{a, vec3->find<Variable>("z")}));
+
+    return 0;
+}
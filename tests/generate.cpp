@@ -0,0 +1,99 @@
+// Generating on several threads writes the same files as generating on one, and an Sdk that was edited after being
+// declared generates either way.
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <sdkgenny.hpp>
+
+#include "check.hpp"
+
+namespace fs = std::filesystem;
+
+static std::string read(const fs::path& path) {
+    std::ifstream file{path};
+    std::ostringstream os{};
+
+    os << file.rdbuf();
+
+    return os.str();
+}
+
+// Whether both directories hold the same files with the same contents, besides file_list.txt naming its own directory.
+static bool same_files(const fs::path& a, const fs::path& b) {
+    size_t count{};
+
+    for (auto&& entry : fs::recursive_directory_iterator{a}) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+
+        auto relative = fs::relative(entry.path(), a);
+        auto other = b / relative;
+
+        if (!fs::exists(other)) {
+            return false;
+        }
+
+        auto contents = read(entry.path());
+        auto other_contents = read(other);
+
+        if (relative == "file_list.txt") {
+            for (size_t i{}; (i = contents.find(a.string(), i)) != std::string::npos;) {
+                contents.replace(i, a.string().size(), b.string());
+            }
+        }
+
+        if (contents != other_contents) {
+            return false;
+        }
+
+        ++count;
+    }
+
+    for (auto&& entry : fs::recursive_directory_iterator{b}) {
+        count -= entry.is_regular_file() ? 1 : 0;
+    }
+
+    return count == 0;
+}
+
+int main() {
+    sdkgenny::Sdk sdk{};
+    auto g = sdk.global_ns();
+    auto int_t = g->type("int")->size(4);
+    auto a = g->struct_("A");
+    auto b = g->struct_("B");
+    auto c = g->namespace_("ns")->struct_("C");
+
+    b->variable("x")->type(int_t)->append();
+    c->variable("x")->type(int_t)->append();
+    c->virtual_function("f")->vtable_index(0);
+    c->function("g")->returns(int_t)->procedure("return x;");
+    a->variable("b")->type(b)->append();
+    a->variable("b")->type(c);
+    b->variable("a")->type(a)->append();
+
+    for (auto i = 0; i < 64; ++i) {
+        auto s = g->namespace_("bulk" + std::to_string(i % 4))->struct_("S" + std::to_string(i));
+
+        s->variable("b")->type(b)->append();
+        s->variable("next")->type(s->ptr())->append();
+        s->function("f")->procedure("return;");
+    }
+
+    auto root = fs::temp_directory_path() / "sdkgenny_test_generate";
+
+    fs::remove_all(root);
+    sdk.generate(root / "serial");
+    sdk.generate(root / "parallel", 4);
+
+    CHECK(fs::exists(root / "serial" / "A.hpp"));
+    CHECK(fs::exists(root / "serial" / "ns" / "C.cpp"));
+    CHECK(same_files(root / "serial", root / "parallel"));
+
+    fs::remove_all(root);
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+// Struct::instantiate() hands out one instance per template and argument list, cached by the arguments until the
+// instance is renamed or removed, after which it goes back to looking instances up by name.
+#include <vector>
+
+#include <sdkgenny.hpp>
+
+#include "check.hpp"
+
+using sdkgenny::Struct;
+using sdkgenny::Type;
+
+int main() {
+    sdkgenny::Sdk sdk{};
+    auto g = sdk.global_ns();
+    auto int_t = g->type("int")->size(4);
+    auto float_t = g->type("float")->size(4);
+    auto box = g->struct_("Box");
+
+    box->variable("v")->type(box->template_parameter("T"));
+
+    // The same arguments give the same instance, different ones a different instance.
+    auto box_int = box->instantiate({int_t});
+
+    CHECK(box_int != nullptr);
+    CHECK(box_int->name() == "Box<int>");
+    CHECK(box_int->template_source() == box);
+    CHECK(box_int->template_arguments() == std::vector<Type*>{int_t});
+    CHECK(box->instantiate({int_t}) == box_int);
+
+    auto box_float = box->instantiate({float_t});
+
+    CHECK(box_float != box_int);
+    CHECK(box_float->name() == "Box<float>");
+    CHECK(box->instantiate({float_t}) == box_float);
+    CHECK(box->instantiate({int_t->ptr()}) != box_int);
+    CHECK(box->instantiate({int_t, float_t}) == nullptr);
+
+    // A renamed instance is no longer handed out for its arguments, and a new one takes its name.
+    box_float->name("Renamed");
+
+    auto box_float2 = box->instantiate({float_t});
+
+    CHECK(box_float2 != box_float);
+    CHECK(box_float2->name() == "Box<float>");
+    CHECK(box->instantiate({float_t}) == box_float2);
+    CHECK(g->find<Struct>("Renamed") == box_float);
+
+    // Nor is a removed one, but whatever has the instance's name is once it's back.
+    auto removed = g->remove(box_int);
+
+    CHECK(g->find<Struct>("Box<int>") == nullptr);
+
+    auto box_int2 = box->instantiate({int_t});
+
+    CHECK(box_int2 != box_int);
+    CHECK(box_int2->name() == "Box<int>");
+
+    g->remove(box_int2);
+    g->add(std::move(removed));
+
+    CHECK(box->instantiate({int_t}) == box_int);
+    CHECK(box->instantiate({int_t}) == box_int);
+
+    // Instances of one template aren't mistaken for another's.
+    auto pair = g->struct_("Pair");
+
+    pair->variable("v")->type(pair->template_parameter("T"));
+
+    CHECK(pair->instantiate({int_t}) != box_int);
+    CHECK(pair->instantiate({int_t})->name() == "Pair<int>");
+
+    return 0;
+}
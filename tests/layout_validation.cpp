@@ -0,0 +1,154 @@
+// Struct::validate_layout() reports each kind of layout problem once, naming the fields involved, and leaves alone
+// what generation lays out fine: sizeless fields, bitfields sharing a storage unit, templates and their instances.
+#include <vector>
+
+#include <sdkgenny.hpp>
+
+#include "check.hpp"
+
+using sdkgenny::Struct;
+using sdkgenny::Variable;
+
+using Issue = Struct::LayoutIssue;
+
+static std::vector<Issue> issues_of(const Struct* s) {
+    std::vector<Issue> issues{};
+
+    s->validate_layout(issues);
+
+    return issues;
+}
+
+int main() {
+    sdkgenny::Sdk sdk{};
+    auto g = sdk.global_ns();
+    auto int_t = g->type("int")->size(4);
+    auto short_t = g->type("short")->size(2);
+    auto char_t = g->type("char")->size(1);
+
+    auto clean = g->struct_("Clean");
+
+    clean->variable("a")->type(int_t)->offset(0);
+    clean->variable("b")->type(short_t)->offset(4);
+    clean->variable("c")->type(g->type("empty"))->offset(2);
+
+    CHECK(issues_of(clean).empty());
+
+    // Fields sharing bytes, reported against the field reaching furthest before them.
+    auto overlap = g->struct_("Overlap");
+    auto a = overlap->variable("a")->type(int_t)->offset(0);
+    auto b = overlap->variable("b")->type(int_t)->offset(2);
+
+    overlap->variable("c")->type(short_t)->offset(5);
+
+    auto issues = issues_of(overlap);
+
+    CHECK(issues.size() == 2);
+    CHECK(issues[0].kind == Issue::OVERLAP);
+    CHECK(issues[0].struct_ == overlap);
+    CHECK(issues[0].var == b && issues[0].other == a);
+    CHECK(issues[1].var == overlap->find<Variable>("c") && issues[1].other == b);
+    CHECK(!issues[0].message.empty());
+
+    // Fields ending past an explicit size.
+    auto bounded = g->struct_("Bounded")->size(8);
+    auto past = bounded->variable("past")->type(int_t)->offset(6);
+
+    bounded->variable("fits")->type(int_t)->offset(0);
+
+    issues = issues_of(bounded);
+
+    CHECK(issues.size() == 1);
+    CHECK(issues[0].kind == Issue::OUT_OF_BOUNDS);
+    CHECK(issues[0].var == past && issues[0].other == nullptr);
+
+    // Bitfields that don't fit in their type.
+    auto wide = g->struct_("Wide");
+    auto too_wide = wide->variable("too_wide")->type(char_t)->offset(0)->bit_size(4)->bit_offset(6);
+
+    issues = issues_of(wide);
+
+    CHECK(issues.size() == 1);
+    CHECK(issues[0].kind == Issue::BITFIELD);
+    CHECK(issues[0].var == too_wide && issues[0].other == nullptr);
+
+    // Bitfields sharing a storage unit: fine with the same type and their own bits, not otherwise.
+    auto bits = g->struct_("Bits");
+
+    bits->variable("lo")->type(int_t)->offset(0)->bit_size(4)->bit_offset(0);
+    bits->variable("hi")->type(int_t)->offset(0)->bit_size(4)->bit_offset(4);
+
+    CHECK(issues_of(bits).empty());
+
+    // Reported in bit order, against the bitfield reaching furthest before them.
+    auto lo = bits->find<Variable>("lo");
+    auto hi = bits->find<Variable>("hi");
+    auto shared = bits->variable("shared")->type(int_t)->offset(0)->bit_size(4)->bit_offset(2);
+
+    issues = issues_of(bits);
+
+    CHECK(issues.size() == 2);
+    CHECK(issues[0].kind == Issue::BITFIELD);
+    CHECK(issues[0].var == shared && issues[0].other == lo);
+    CHECK(issues[1].var == hi && issues[1].other == shared);
+
+    auto mixed = g->struct_("Mixed");
+    auto first = mixed->variable("first")->type(int_t)->offset(0)->bit_size(4)->bit_offset(0);
+    auto other_type = mixed->variable("other_type")->type(short_t)->offset(0)->bit_size(4)->bit_offset(4);
+
+    issues = issues_of(mixed);
+
+    CHECK(issues.size() == 1);
+    CHECK(issues[0].kind == Issue::BITFIELD);
+    CHECK(issues[0].var == other_type && issues[0].other == first);
+
+    // Fields starting within the parents, or within the vtable pointer when there are none.
+    auto base = g->struct_("Base");
+
+    base->variable("x")->type(int_t)->offset(0);
+    base->variable("y")->type(int_t)->offset(4);
+
+    auto derived = g->struct_("Derived")->parent(base);
+    auto inside = derived->variable("inside")->type(int_t)->offset(4);
+
+    derived->variable("after")->type(int_t)->offset(8);
+
+    issues = issues_of(derived);
+
+    CHECK(issues.size() == 1);
+    CHECK(issues[0].kind == Issue::PARENT_OVERLAP);
+    CHECK(issues[0].var == inside && issues[0].other == nullptr);
+
+    auto virtual_ = g->struct_("Virtual");
+
+    virtual_->virtual_function("f");
+
+    auto in_vtable = virtual_->variable("in_vtable")->type(int_t)->offset(0);
+
+    virtual_->variable("after")->type(int_t)->offset(sizeof(uintptr_t));
+
+    issues = issues_of(virtual_);
+
+    CHECK(issues.size() == 1);
+    CHECK(issues[0].kind == Issue::PARENT_OVERLAP);
+    CHECK(issues[0].var == in_vtable);
+
+    // Templates and their instances are skipped, however their fields overlap.
+    auto box = g->struct_("Box");
+
+    box->variable("a")->type(int_t)->offset(0);
+    box->variable("b")->type(int_t)->offset(2);
+    box->variable("v")->type(box->template_parameter("T"))->offset(0);
+
+    CHECK(issues_of(box).empty());
+
+    auto box_int = box->instantiate({int_t});
+
+    CHECK(box_int != nullptr);
+    CHECK(issues_of(box_int).empty());
+
+    // The Sdk collects the issues of every struct.
+    CHECK(sdk.validate_layouts().size() == 2 + 1 + 1 + 2 + 1 + 1 + 1);
+
+    return 0;
+}
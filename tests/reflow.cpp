@@ -0,0 +1,62 @@
+// Struct::reflow() and Sdk::reflow() only report the structs an edit actually changed, including those it changed just
+// by resizing a field they embed.
+#include <algorithm>
+
+#include <sdkgenny.hpp>
+
+#include "check.hpp"
+
+using sdkgenny::Struct;
+
+int main() {
+    sdkgenny::Sdk sdk{};
+    auto g = sdk.global_ns();
+    auto char_t = g->type("char")->size(1);
+    auto long_t = g->type("long")->size(8);
+
+    auto a = g->struct_("A");
+    auto x = a->variable("x")->type(char_t)->append();
+    a->variable("y")->type(char_t)->append();
+    auto pinned = a->variable("p")->type(char_t)->offset(0x10);
+
+    auto b = g->struct_("B");
+    b->variable("h")->type(char_t)->append();
+    b->variable("arr")->type(a->array_(2))->append();
+    auto after = b->variable("after")->type(char_t)->append();
+
+    auto d = g->struct_("D")->parent(a);
+    auto z = d->variable("z")->type(char_t)->append();
+
+    CHECK(after->offset() == 1 + 2 * 17);
+    CHECK(z->offset() == 17);
+
+    // Nothing was edited.
+    CHECK(!a->reflow());
+    CHECK(!b->reflow());
+    CHECK(sdk.reflow({a, b, d}).empty());
+
+    // Setting the same type again changes nothing either.
+    x->type(char_t);
+    CHECK(sdk.reflow({a}).empty());
+
+    // y moves but A keeps its size, so nothing depending on it has to change.
+    x->type(long_t);
+    CHECK(sdk.reflow({a}) == std::vector<Struct*>{a});
+
+    // The last field grows A without moving anything in it, which still moves the fields after it in B and D, even
+    // when A's size was looked at in between.
+    pinned->type(long_t);
+    CHECK(a->size() == 0x18);
+
+    auto changed = sdk.reflow({a});
+
+    CHECK(changed.size() == 3 && changed.front() == a);
+    CHECK(std::ranges::find(changed, b) != changed.end());
+    CHECK(std::ranges::find(changed, d) != changed.end());
+    CHECK(after->offset() == 1 + 2 * 0x18);
+    CHECK(z->offset() == 0x18);
+
+    CHECK(sdk.reflow({a}).empty());
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+// Resolving layouts up front gives the same sizes as computing them lazily, serially or not, including on an Sdk whose
+// fields were retyped after being declared.
+#include <vector>
+
+#include <sdkgenny.hpp>
+
+#include "check.hpp"
+
+// A has a field of type B that is retyped to C, after which B gets a field of type A. Only B -> A -> C is left.
+static void build(sdkgenny::Sdk& sdk) {
+    auto g = sdk.global_ns();
+    auto int_t = g->type("int")->size(4);
+    auto a = g->struct_("A");
+    auto b = g->struct_("B");
+    auto c = g->struct_("C");
+
+    b->variable("x")->type(int_t)->append();
+    c->variable("x")->type(int_t)->append();
+    c->variable("y")->type(int_t)->append();
+    c->virtual_function("f")->vtable_index(0);
+    a->variable("b")->type(b)->append();
+    a->variable("b")->type(c);
+    b->variable("a")->type(a->array_(2))->append();
+    g->struct_("D")->parent(b)->variable("z")->type(int_t)->append();
+}
+
+static std::vector<size_t> sizes(sdkgenny::Sdk& sdk) {
+    std::vector<size_t> sizes{};
+
+    for (auto&& s : sdk.global_ns()->get_all<sdkgenny::Struct>()) {
+        sizes.emplace_back(s->size());
+        sizes.emplace_back(s->vtable().size());
+    }
+
+    return sizes;
+}
+
+int main() {
+    sdkgenny::Sdk lazy{};
+
+    build(lazy);
+
+    auto expected = sizes(lazy);
+
+    CHECK(lazy.global_ns()->find<sdkgenny::Struct>("B")->size() == 4 + 2 * 8);
+
+    for (auto jobs : {1, 4}) {
+        sdkgenny::Sdk sdk{};
+
+        build(sdk);
+        sdk.resolve_layouts(jobs);
+
+        CHECK(sizes(sdk) == expected);
+    }
+
+    return 0;
+}
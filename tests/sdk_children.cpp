@@ -0,0 +1,37 @@
+// Objects can be added to an Sdk directly rather than to its global namespace, and are found and torn down with it.
+#include <string>
+
+#include <sdkgenny.hpp>
+
+#include "check.hpp"
+
+using sdkgenny::Namespace;
+
+int main() {
+    {
+        sdkgenny::Sdk sdk{};
+        auto ns = sdk.find_or_add<Namespace>("n");
+
+        CHECK(sdk.find<Namespace>("n") == ns);
+        CHECK(sdk.get_all<Namespace>().size() == 1);
+    }
+
+    // Enough of them for the Sdk to index them by name.
+    {
+        sdkgenny::Sdk sdk{};
+
+        for (auto i = 0; i < 32; ++i) {
+            sdk.find_or_add<Namespace>("n" + std::to_string(i))->struct_("s");
+        }
+
+        auto ns = sdk.find<Namespace>("n7");
+
+        CHECK(ns != nullptr);
+        CHECK(ns->find<sdkgenny::Struct>("s") != nullptr);
+        CHECK(sdk.remove(ns) != nullptr);
+        CHECK(sdk.find<Namespace>("n7") == nullptr);
+        CHECK(sdk.get_all<Namespace>().size() == 31);
+    }
+
+    return 0;
+}
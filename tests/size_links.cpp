@@ -0,0 +1,95 @@
+// Retyping a field has to unlink the struct's size from the old type, otherwise edits can leave links (and cycles)
+// behind that the actual layout doesn't have. Types that leave an Sdk have to be unlinked from it when it's destroyed.
+#include <memory>
+
+#include <sdkgenny.hpp>
+
+#include "check.hpp"
+
+using sdkgenny::Struct;
+using sdkgenny::Type;
+using sdkgenny::Variable;
+
+static int check_retyping() {
+    sdkgenny::Sdk sdk{};
+    auto g = sdk.global_ns();
+    auto int_t = g->type("int")->size(4);
+    auto a = g->struct_("A");
+    auto b = g->struct_("B");
+    auto c = g->struct_("C");
+
+    b->variable("x")->type(int_t)->append();
+    c->variable("x")->type(int_t)->append();
+    c->variable("y")->type(int_t)->append();
+
+    auto field = a->variable("b")->type(b)->append();
+
+    CHECK(a->size() == 4);
+
+    field->type(c);
+    b->variable("a")->type(a)->append();
+
+    CHECK(a->size() == 8);
+    CHECK(b->size() == 12);
+
+    // Only the reverse dependency is left, so resizing C reaches B through A...
+    c->variable("z")->type(int_t)->append();
+
+    CHECK(a->size() == 12);
+    CHECK(b->size() == 16);
+
+    // ...while resizing B no longer touches A.
+    b->variable("w")->type(int_t)->append();
+
+    CHECK(a->size() == 12);
+    CHECK(b->size() == 20);
+
+    // A link stays while another field still uses the type.
+    auto d = g->struct_("D");
+    auto first = d->variable("c0")->type(c)->append();
+
+    d->variable("c1")->type(c)->append();
+    first->type(int_t);
+    c->variable("w")->type(int_t)->append();
+
+    CHECK(d->size() == 12 + 16);
+
+    return 0;
+}
+
+static int check_escaped() {
+    // Allocated on the heap so nothing keeps the Sdk's arena alive once it's gone.
+    std::unique_ptr<sdkgenny::Object> removed_struct{};
+    std::unique_ptr<sdkgenny::Object> removed_type{};
+
+    {
+        sdkgenny::Sdk sdk{};
+        auto g = sdk.global_ns();
+        auto int_t = g->type("int")->size(4);
+        auto s = g->add(std::make_unique<Struct>("S"));
+
+        s->add(std::make_unique<Variable>("x"))->type(int_t);
+        removed_struct = g->remove(s);
+
+        auto short_t = g->add(std::make_unique<Type>("short"))->size(2);
+
+        g->struct_("T")->variable("x")->type(short_t);
+        removed_type = g->remove(short_t);
+    }
+
+    // Neither may reach back into the Sdk.
+    removed_type->as<Type>()->size(8);
+
+    CHECK(removed_type->as<Type>()->size() == 8);
+
+    removed_struct.reset();
+
+    return 0;
+}
+
+int main() {
+    CHECK(check_retyping() == 0);
+    CHECK(check_escaped() == 0);
+
+    return 0;
+}
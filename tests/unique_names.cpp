@@ -0,0 +1,46 @@
+// Members of a struct named like members of its parents get the lowest suffix none of the parents use, which keeps
+// up as the parents' members are added, removed and renamed.
+#include <string>
+
+#include <sdkgenny.hpp>
+
+#include "check.hpp"
+
+int main() {
+    sdkgenny::Sdk sdk{};
+    auto g = sdk.global_ns();
+    auto a = g->struct_("A");
+    auto b = g->struct_("B");
+
+    a->variable("x");
+    a->variable("x0");
+    a->variable("x1");
+    b->variable("x2");
+
+    auto c = g->struct_("C")->parent(a)->parent(b);
+
+    CHECK(c->variable("x")->name() == "x3");
+    CHECK(c->variable("y")->name() == "y");
+    CHECK(g->struct_("D")->parent(a)->variable("x")->name() == "x2");
+
+    // The suffixes a parent was known to use are forgotten once one of them is free again.
+    a->find<sdkgenny::Variable>("x0")->name("z");
+
+    CHECK(g->struct_("E")->parent(a)->variable("x")->name() == "x0");
+
+    a->remove(a->find<sdkgenny::Variable>("x1"));
+    a->variable("x0");
+
+    CHECK(g->struct_("F")->parent(a)->variable("x")->name() == "x1");
+
+    // Longer suffixes than the ones probed so far.
+    a->variable("x1");
+
+    for (auto i = 3; i < 12; ++i) {
+        b->variable("x" + std::to_string(i));
+    }
+
+    CHECK(g->struct_("G")->parent(a)->parent(b)->function("x")->name() == "x12");
+
+    return 0;
+}